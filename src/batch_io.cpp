@@ -0,0 +1,438 @@
+#include "batch_io.h"
+
+#include <algorithm>
+#include <fstream>
+#include <future>
+
+#include "deck_io.h"
+#include "thread_pool.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define NESLIDES_HAS_IO_URING 1
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    void StreamRead(BatchRead &read) {
+        read.ok = ReadFile(read.path, read.data);
+    }
+
+    void StreamWrite(BatchWrite &write) {
+        std::ofstream file{write.path, std::ios::binary};
+        write.ok = file.is_open() && file.write(write.data.data(), static_cast<std::streamsize>(write.data.size()));
+    }
+
+#ifdef _WIN32
+    void PositionalRead(BatchRead &read) {
+        StreamRead(read);
+    }
+
+    void PositionalWrite(BatchWrite &write) {
+        StreamWrite(write);
+    }
+#else
+    void PositionalRead(BatchRead &read) {
+        int const fd{open(read.path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (fd < 0)
+            return;
+
+        struct stat status{};
+        if (fstat(fd, &status) == 0) {
+            read.data.resize(static_cast<std::size_t>(status.st_size));
+
+            std::size_t offset{0};
+            while (offset < read.data.size()) {
+                ssize_t const result{pread(fd, read.data.data() + offset, read.data.size() - offset, static_cast<off_t>(offset))};
+                if (result <= 0)
+                    break;
+                offset += static_cast<std::size_t>(result);
+            }
+
+            read.data.resize(offset);
+            read.ok = offset == static_cast<std::size_t>(status.st_size);
+        }
+
+        close(fd);
+    }
+
+    void PositionalWrite(BatchWrite &write) {
+        int const fd{open(write.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+        if (fd < 0)
+            return;
+
+        std::size_t offset{0};
+        while (offset < write.data.size()) {
+            ssize_t const result{pwrite(fd, write.data.data() + offset, write.data.size() - offset, static_cast<off_t>(offset))};
+            if (result <= 0)
+                break;
+            offset += static_cast<std::size_t>(result);
+        }
+
+        write.ok = close(fd) == 0 && offset == write.data.size();
+    }
+#endif
+
+#ifdef NESLIDES_HAS_IO_URING
+    // A minimal io_uring over the raw syscalls, just enough to keep a window of whole-file reads and writes in flight.
+    class IoUring final {
+    public:
+        explicit IoUring(unsigned entries) {
+            io_uring_params params{};
+            fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+            if (fd_ < 0)
+                return;
+
+            sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            bool const single_mmap{(params.features & IORING_FEAT_SINGLE_MMAP) != 0};
+            if (single_mmap)
+                sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+            sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+            cq_ring_ = single_mmap ? sq_ring_ : mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+            sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+            void *const sqes{mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES)};
+            sqes_ = sqes == MAP_FAILED ? nullptr : static_cast<io_uring_sqe *>(sqes);
+            if (sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED || !sqes_) {
+                Release();
+                return;
+            }
+
+            auto *const sq_bytes{static_cast<char *>(sq_ring_)};
+            auto *const cq_bytes{static_cast<char *>(cq_ring_)};
+            sq_head_ = reinterpret_cast<unsigned *>(sq_bytes + params.sq_off.head);
+            sq_tail_ = reinterpret_cast<unsigned *>(sq_bytes + params.sq_off.tail);
+            sq_mask_ = *reinterpret_cast<unsigned *>(sq_bytes + params.sq_off.ring_mask);
+            sq_array_ = reinterpret_cast<unsigned *>(sq_bytes + params.sq_off.array);
+            cq_head_ = reinterpret_cast<unsigned *>(cq_bytes + params.cq_off.head);
+            cq_tail_ = reinterpret_cast<unsigned *>(cq_bytes + params.cq_off.tail);
+            cq_mask_ = *reinterpret_cast<unsigned *>(cq_bytes + params.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<io_uring_cqe *>(cq_bytes + params.cq_off.cqes);
+            entries_ = params.sq_entries;
+            local_tail_ = *sq_tail_;
+        }
+
+        ~IoUring() {
+            Release();
+        }
+
+        IoUring(IoUring const &) = delete;
+        IoUring &operator=(IoUring const &) = delete;
+
+        [[nodiscard]]
+        bool IsValid() const noexcept {
+            return fd_ >= 0;
+        }
+
+        [[nodiscard]]
+        unsigned Entries() const noexcept {
+            return entries_;
+        }
+
+        [[nodiscard]]
+        io_uring_sqe *NextSqe() noexcept {
+            unsigned const head{std::atomic_ref{*sq_head_}.load(std::memory_order_acquire)};
+            if (local_tail_ - head >= entries_)
+                return nullptr;
+
+            unsigned const index{local_tail_ & sq_mask_};
+            sq_array_[index] = index;
+            ++local_tail_;
+            ++unsubmitted_;
+
+            io_uring_sqe *const sqe{&sqes_[index]};
+            std::memset(sqe, 0, sizeof(*sqe));
+            return sqe;
+        }
+
+        [[nodiscard]]
+        bool SubmitAndWait(unsigned wait_count) noexcept {
+            std::atomic_ref{*sq_tail_}.store(local_tail_, std::memory_order_release);
+
+            while (true) {
+                long const result{syscall(__NR_io_uring_enter, fd_, unsubmitted_, wait_count, wait_count != 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0)};
+                if (result >= 0) {
+                    unsubmitted_ -= std::min(unsubmitted_, static_cast<unsigned>(result));
+                    return true;
+                }
+
+                if (errno != EINTR)
+                    return false;
+            }
+        }
+
+        [[nodiscard]]
+        bool PopCompletion(io_uring_cqe &out) noexcept {
+            unsigned const head{*cq_head_};
+            if (head == std::atomic_ref{*cq_tail_}.load(std::memory_order_acquire))
+                return false;
+
+            out = cqes_[head & cq_mask_];
+            std::atomic_ref{*cq_head_}.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        int fd_{-1};
+        void *sq_ring_{MAP_FAILED};
+        void *cq_ring_{MAP_FAILED};
+        std::size_t sq_ring_size_{};
+        std::size_t cq_ring_size_{};
+        std::size_t sqes_size_{};
+        unsigned *sq_head_{};
+        unsigned *sq_tail_{};
+        unsigned *sq_array_{};
+        unsigned *cq_head_{};
+        unsigned *cq_tail_{};
+        io_uring_cqe *cqes_{};
+        io_uring_sqe *sqes_{};
+        unsigned sq_mask_{};
+        unsigned cq_mask_{};
+        unsigned entries_{};
+        unsigned local_tail_{};
+        unsigned unsubmitted_{};
+
+        void Release() noexcept {
+            if (sqes_)
+                munmap(sqes_, sqes_size_);
+            if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_)
+                munmap(cq_ring_, cq_ring_size_);
+            if (sq_ring_ != MAP_FAILED)
+                munmap(sq_ring_, sq_ring_size_);
+            if (fd_ >= 0)
+                close(fd_);
+
+            sqes_ = nullptr;
+            sq_ring_ = cq_ring_ = MAP_FAILED;
+            fd_ = -1;
+        }
+    };
+
+    constexpr unsigned c_RingEntries{64};
+
+    // Files are opened in windows of this size so a large archive does not exhaust file descriptors.
+    constexpr std::size_t c_OpenFileWindow{256};
+
+    struct RingTransfer final {
+        int fd;
+        char *buffer;
+        std::size_t size;
+        std::size_t done;
+        bool failed;
+    };
+
+    // Keeps up to Entries() transfers in flight and resubmits short reads and writes until every transfer is done.
+    [[nodiscard]]
+    bool RunTransfers(IoUring &ring, std::span<RingTransfer> transfers, std::uint8_t opcode) {
+        std::deque<std::size_t> queue;
+        for (std::size_t i{0}; i < transfers.size(); ++i) {
+            if (transfers[i].done < transfers[i].size)
+                queue.push_back(i);
+        }
+
+        unsigned in_flight{0};
+        while (!queue.empty() || in_flight != 0) {
+            // The completion queue only has room for so many, more in flight could overflow it.
+            while (!queue.empty() && in_flight < ring.Entries()) {
+                io_uring_sqe *const sqe{ring.NextSqe()};
+                if (!sqe)
+                    break;
+
+                auto const &transfer{transfers[queue.front()]};
+                sqe->opcode = opcode;
+                sqe->fd = transfer.fd;
+                sqe->addr = reinterpret_cast<std::uint64_t>(transfer.buffer + transfer.done);
+                sqe->len = static_cast<std::uint32_t>(std::min<std::size_t>(transfer.size - transfer.done, 1u << 30));
+                sqe->off = transfer.done;
+                sqe->user_data = queue.front();
+                queue.pop_front();
+                ++in_flight;
+            }
+
+            if (!ring.SubmitAndWait(1))
+                return false;
+
+            io_uring_cqe completion{};
+            while (ring.PopCompletion(completion)) {
+                --in_flight;
+                auto &transfer{transfers[completion.user_data]};
+
+                if (completion.res == -EAGAIN || completion.res == -EINTR) {
+                    queue.push_back(completion.user_data);
+                    continue;
+                }
+
+                if (completion.res <= 0) {
+                    transfer.failed = true;
+                    continue;
+                }
+
+                transfer.done += static_cast<std::size_t>(completion.res);
+                if (transfer.done < transfer.size)
+                    queue.push_back(completion.user_data);
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]]
+    bool RingRead(IoUring &ring, std::span<BatchRead> reads) {
+        std::vector<RingTransfer> transfers;
+        transfers.reserve(std::min(reads.size(), c_OpenFileWindow));
+
+        for (std::size_t window{0}; window < reads.size(); window += c_OpenFileWindow) {
+            auto const batch{reads.subspan(window, std::min(c_OpenFileWindow, reads.size() - window))};
+
+            transfers.clear();
+            for (auto &read : batch) {
+                RingTransfer transfer{.fd = open(read.path.c_str(), O_RDONLY | O_CLOEXEC), .buffer = nullptr, .size = 0, .done = 0, .failed = false};
+
+                struct stat status{};
+                if (transfer.fd < 0 || fstat(transfer.fd, &status) != 0) {
+                    transfer.failed = true;
+                } else {
+                    read.data.resize(static_cast<std::size_t>(status.st_size));
+                    transfer.buffer = read.data.data();
+                    transfer.size = read.data.size();
+                }
+                transfers.push_back(transfer);
+            }
+
+            bool const ran{RunTransfers(ring, transfers, IORING_OP_READ)};
+
+            for (std::size_t i{0}; i < batch.size(); ++i) {
+                auto const &transfer{transfers[i]};
+                if (transfer.fd >= 0)
+                    close(transfer.fd);
+
+                batch[i].ok = ran && !transfer.failed && transfer.done == transfer.size;
+            }
+
+            if (!ran)
+                return false;
+        }
+
+        return true;
+    }
+
+    [[nodiscard]]
+    bool RingWrite(IoUring &ring, std::span<BatchWrite> writes) {
+        std::vector<RingTransfer> transfers;
+        transfers.reserve(std::min(writes.size(), c_OpenFileWindow));
+
+        for (std::size_t window{0}; window < writes.size(); window += c_OpenFileWindow) {
+            auto const batch{writes.subspan(window, std::min(c_OpenFileWindow, writes.size() - window))};
+
+            transfers.clear();
+            for (auto const &write : batch) {
+                RingTransfer transfer{
+                    .fd = open(write.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644),
+                    .buffer = const_cast<char *>(write.data.data()),
+                    .size = write.data.size(),
+                    .done = 0,
+                    .failed = false
+                };
+                transfer.failed = transfer.fd < 0;
+                transfers.push_back(transfer);
+            }
+
+            bool const ran{RunTransfers(ring, transfers, IORING_OP_WRITE)};
+
+            for (std::size_t i{0}; i < batch.size(); ++i) {
+                auto const &transfer{transfers[i]};
+                bool const closed{transfer.fd >= 0 && close(transfer.fd) == 0};
+
+                batch[i].ok = ran && closed && !transfer.failed && transfer.done == transfer.size;
+            }
+
+            if (!ran)
+                return false;
+        }
+
+        return true;
+    }
+#endif
+
+    template<typename Request, typename Function>
+    void RunOnPool(std::span<Request> requests, ThreadPool &pool, Function function) {
+        std::vector<std::future<void>> pending;
+        pending.reserve(requests.size());
+
+        for (auto &request : requests)
+            pending.emplace_back(pool.Submit([&request, function] { function(request); }));
+
+        for (auto &future : pending)
+            future.get();
+    }
+}
+
+std::string_view BatchIoBackendName(BatchIoBackend backend) noexcept {
+    switch (backend) {
+        case BatchIoBackend::IoUring:
+            return "io_uring";
+        case BatchIoBackend::ThreadPool:
+            return "thread pool";
+        case BatchIoBackend::Stream:
+            return "stream";
+    }
+
+    return "unknown";
+}
+
+BatchIoBackend DefaultBatchIoBackend() {
+#ifdef NESLIDES_HAS_IO_URING
+    if (IoUring{1}.IsValid())
+        return BatchIoBackend::IoUring;
+#endif
+
+    return BatchIoBackend::ThreadPool;
+}
+
+BatchIoBackend ReadFiles(std::span<BatchRead> reads, BatchIoBackend backend, ThreadPool &pool) {
+#ifdef NESLIDES_HAS_IO_URING
+    if (backend == BatchIoBackend::IoUring) {
+        IoUring ring{c_RingEntries};
+        if (ring.IsValid() && RingRead(ring, reads))
+            return BatchIoBackend::IoUring;
+    }
+#endif
+
+    if (backend == BatchIoBackend::Stream) {
+        std::ranges::for_each(reads, StreamRead);
+        return BatchIoBackend::Stream;
+    }
+
+    RunOnPool(reads, pool, PositionalRead);
+    return BatchIoBackend::ThreadPool;
+}
+
+BatchIoBackend WriteFiles(std::span<BatchWrite> writes, BatchIoBackend backend, ThreadPool &pool) {
+#ifdef NESLIDES_HAS_IO_URING
+    if (backend == BatchIoBackend::IoUring) {
+        IoUring ring{c_RingEntries};
+        if (ring.IsValid() && RingWrite(ring, writes))
+            return BatchIoBackend::IoUring;
+    }
+#endif
+
+    if (backend == BatchIoBackend::Stream) {
+        std::ranges::for_each(writes, StreamWrite);
+        return BatchIoBackend::Stream;
+    }
+
+    RunOnPool(writes, pool, PositionalWrite);
+    return BatchIoBackend::ThreadPool;
+}
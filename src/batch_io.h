@@ -0,0 +1,40 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ThreadPool;
+
+enum class BatchIoBackend {
+    IoUring,
+    ThreadPool,
+    Stream
+};
+
+struct BatchRead final {
+    std::filesystem::path path;
+    std::string data;
+    bool ok{false};
+};
+
+struct BatchWrite final {
+    std::filesystem::path path;
+    std::string_view data;
+    bool ok{false};
+};
+
+[[nodiscard]]
+std::string_view BatchIoBackendName(BatchIoBackend backend) noexcept;
+
+// The fastest backend this build and kernel support. io_uring can be compiled in but still be refused at runtime,
+// e.g. by a container's seccomp profile, so this probes for it.
+[[nodiscard]]
+BatchIoBackend DefaultBatchIoBackend();
+
+// Reads or writes many whole files at once. Stream is the plain sequential ifstream/ofstream path the editor uses.
+// Falls back to ThreadPool when io_uring is requested but unavailable. Returns the backend that did the work.
+BatchIoBackend ReadFiles(std::span<BatchRead> reads, BatchIoBackend backend, ThreadPool &pool);
+BatchIoBackend WriteFiles(std::span<BatchWrite> writes, BatchIoBackend backend, ThreadPool &pool);
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Braille dot bits by row, for the left and the right column of a cell. The preview and the thumbnails draw pixels in
+// the terminal as braille cells, 2x4 dots a character.
+constexpr std::array<std::array<std::uint8_t, 2>, 4> c_BrailleDots{{{0x01, 0x08}, {0x02, 0x10}, {0x04, 0x20}, {0x40, 0x80}}};
+
+// Appends U+2800 plus the dots, as UTF-8.
+inline void AppendBraille(std::string &out, std::uint8_t dots) {
+    out.push_back(static_cast<char>(0xE2));
+    out.push_back(static_cast<char>(0xA0 | (dots >> 6)));
+    out.push_back(static_cast<char>(0x80 | (dots & 0x3F)));
+}
@@ -0,0 +1,189 @@
+#include "converter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "batch_io.h"
+#include "deck_io.h"
+#include "export.h"
+#include "thread_pool.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    [[nodiscard]]
+    double SecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Names the backend that did the work, which is not the one asked for when io_uring fell back to the pool.
+    void PrintThroughput(std::string_view what, std::size_t files, double seconds, BatchIoBackend used,
+                         BatchIoBackend requested) {
+        auto const via{used == requested
+            ? std::string{BatchIoBackendName(used)}
+            : std::format("{} instead of {}", BatchIoBackendName(used), BatchIoBackendName(requested))};
+        std::cout << std::format("{} {} files in {:.3f} ms via {}: {:.0f} files/s\n", what, files, seconds * 1000.0, via,
+                                 seconds > 0.0 ? static_cast<double>(files) / seconds : 0.0);
+    }
+
+    constexpr int c_BenchRounds{5};
+
+    [[nodiscard]]
+    double Median(std::vector<double> samples) {
+        auto const middle{samples.begin() + static_cast<std::ptrdiff_t>(samples.size() / 2)};
+        std::ranges::nth_element(samples, middle);
+        return *middle;
+    }
+
+    // Reads every deck and writes it back out with each backend, so the batch backends can be compared with the
+    // stream path on the same files without the ROM builds in between. A discarded first read warms the page cache,
+    // then every round runs the backends in a rotated order so none always goes first, and the medians are reported.
+    void RunIoBenchmark(std::span<std::filesystem::path const> decks, std::filesystem::path const &directory, ThreadPool &pool) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+
+        std::vector backends{BatchIoBackend::Stream, BatchIoBackend::ThreadPool};
+        if (DefaultBatchIoBackend() == BatchIoBackend::IoUring)
+            backends.push_back(BatchIoBackend::IoUring);
+
+        auto const make_reads{[&] {
+            std::vector<BatchRead> reads(decks.size());
+            for (std::size_t i{0}; i < decks.size(); ++i)
+                reads[i].path = decks[i];
+            return reads;
+        }};
+
+        {
+            auto warm_up{make_reads()};
+            (void)ReadFiles(warm_up, BatchIoBackend::Stream, pool);
+        }
+
+        std::vector<std::vector<double>> read_seconds(backends.size());
+        std::vector<std::vector<double>> write_seconds(backends.size());
+        std::vector<BatchIoBackend> read_used(backends), write_used(backends);
+        for (int round{0}; round < c_BenchRounds; ++round) {
+            for (std::size_t turn{0}; turn < backends.size(); ++turn) {
+                std::size_t const index{(turn + static_cast<std::size_t>(round)) % backends.size()};
+                auto const backend{backends[index]};
+
+                auto reads{make_reads()};
+                auto const read_start{Clock::now()};
+                read_used[index] = ReadFiles(reads, backend, pool);
+                read_seconds[index].push_back(SecondsSince(read_start));
+
+                std::vector<BatchWrite> writes(reads.size());
+                for (std::size_t i{0}; i < reads.size(); ++i) {
+                    writes[i].path = directory / reads[i].path.filename();
+                    writes[i].data = reads[i].data;
+                }
+
+                auto const write_start{Clock::now()};
+                write_used[index] = WriteFiles(writes, backend, pool);
+                write_seconds[index].push_back(SecondsSince(write_start));
+            }
+        }
+
+        for (std::size_t index{0}; index < backends.size(); ++index) {
+            PrintThroughput("bench: read", decks.size(), Median(read_seconds[index]), read_used[index], backends[index]);
+            PrintThroughput("bench: wrote", decks.size(), Median(write_seconds[index]), write_used[index], backends[index]);
+        }
+
+        std::filesystem::remove_all(directory, error);
+    }
+}
+
+int RunConverter(std::span<char const *const> arguments) {
+    if (arguments.empty()) {
+        std::cerr << "usage: NESlidesEditor --convert <output directory> [--io=uring|pool|stream] [--io-bench] <deck or directory>...\n";
+        return 1;
+    }
+
+    std::filesystem::path const output_directory{arguments.front()};
+    BatchIoBackend backend{DefaultBatchIoBackend()};
+    bool run_benchmark{false};
+    std::vector<std::string_view> inputs;
+
+    for (std::string_view const argument : arguments.subspan(1)) {
+        if (argument == "--io=uring")
+            backend = BatchIoBackend::IoUring;
+        else if (argument == "--io=pool")
+            backend = BatchIoBackend::ThreadPool;
+        else if (argument == "--io=stream")
+            backend = BatchIoBackend::Stream;
+        else if (argument == "--io-bench")
+            run_benchmark = true;
+        else
+            inputs.emplace_back(argument);
+    }
+
+    std::vector<std::filesystem::path> const decks{CollectDecks(inputs)};
+    if (decks.empty()) {
+        std::cerr << "no decks to convert\n";
+        return 1;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(output_directory, error);
+    if (error) {
+        std::cerr << std::format("cannot create {}: {}\n", output_directory.string(), error.message());
+        return 1;
+    }
+
+    ThreadPool pool;
+
+    if (run_benchmark)
+        RunIoBenchmark(decks, output_directory / "io-bench", pool);
+
+    std::vector<BatchRead> reads(decks.size());
+    for (std::size_t i{0}; i < decks.size(); ++i)
+        reads[i].path = decks[i];
+
+    auto const read_start{Clock::now()};
+    auto const read_backend{ReadFiles(reads, backend, pool)};
+    PrintThroughput("read", reads.size(), SecondsSince(read_start), read_backend, backend);
+
+    ExportCache cache;
+    std::vector<std::string> roms;
+    std::vector<BatchWrite> writes;
+    roms.reserve(reads.size());
+    writes.reserve(reads.size());
+    int failures{0};
+
+    for (auto const &read : reads) {
+        Slides slides;
+        if (read.ok) {
+            if (auto const damaged{ParseSlides(read.data, slides)}; damaged > 0)
+                std::cerr << std::format("{}: {} slides lost text a slide cannot hold\n", read.path.string(), damaged);
+        }
+        std::filesystem::path rom_path;
+        std::string rom;
+
+        if (slides.empty() || !Export(slides, cache) || (rom_path = ExportedRomPath()).empty() || !ReadFile(rom_path, rom)) {
+            std::cerr << std::format("failed to convert {}\n", read.path.string());
+            ++failures;
+            continue;
+        }
+
+        auto &write{writes.emplace_back()};
+        write.path = output_directory / read.path.stem();
+        write.path += rom_path.extension();
+        write.data = roms.emplace_back(std::move(rom));
+    }
+
+    auto const write_start{Clock::now()};
+    auto const write_backend{WriteFiles(writes, backend, pool)};
+    PrintThroughput("wrote", writes.size(), SecondsSince(write_start), write_backend, backend);
+
+    for (auto const &write : writes) {
+        if (!write.ok) {
+            std::cerr << std::format("failed to write {}\n", write.path.string());
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
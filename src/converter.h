@@ -0,0 +1,10 @@
+#pragma once
+
+#include <span>
+
+// Headless batch mode, run as
+//   NESlidesEditor --convert <output directory> [--io=uring|pool|stream] [--io-bench] <deck or directory>...
+// Every deck is read in one batch, built into a ROM and the ROMs are written out in one batch as <deck name>.nes.
+// --io-bench first times reading and writing the decks with every backend, reporting the median of several rounds.
+[[nodiscard]]
+int RunConverter(std::span<char const *const> arguments);
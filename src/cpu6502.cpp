@@ -0,0 +1,344 @@
+#include "cpu6502.h"
+
+#include <array>
+
+namespace {
+    // Base cycles per opcode, unofficial ones included so a stray one still takes time.
+    constexpr std::array<std::uint8_t, 256> c_Cycles{
+        7, 6, 2, 8, 3, 3, 5, 5, 3, 2, 2, 2, 4, 4, 6, 6,
+        2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7,
+        6, 6, 2, 8, 3, 3, 5, 5, 4, 2, 2, 2, 4, 4, 6, 6,
+        2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7,
+        6, 6, 2, 8, 3, 3, 5, 5, 3, 2, 2, 2, 3, 4, 6, 6,
+        2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7,
+        6, 6, 2, 8, 3, 3, 5, 5, 4, 2, 2, 2, 5, 4, 6, 6,
+        2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7,
+        2, 6, 2, 6, 3, 3, 3, 3, 2, 2, 2, 2, 4, 4, 4, 4,
+        2, 6, 2, 6, 4, 4, 4, 4, 2, 5, 2, 5, 5, 5, 5, 5,
+        2, 6, 2, 6, 3, 3, 3, 3, 2, 2, 2, 2, 4, 4, 4, 4,
+        2, 5, 2, 5, 4, 4, 4, 4, 2, 4, 2, 4, 4, 4, 4, 4,
+        2, 6, 2, 8, 3, 3, 5, 5, 2, 2, 2, 2, 4, 4, 6, 6,
+        2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7,
+        2, 6, 2, 8, 3, 3, 5, 5, 2, 2, 2, 2, 4, 4, 6, 6,
+        2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7
+    };
+
+    constexpr std::uint16_t c_NmiVector{0xFFFA};
+    constexpr std::uint16_t c_ResetVector{0xFFFC};
+    constexpr std::uint16_t c_IrqVector{0xFFFE};
+
+    [[nodiscard]]
+    bool CrossesPage(std::uint16_t from, std::uint16_t to) noexcept {
+        return (from & 0xFF00) != (to & 0xFF00);
+    }
+}
+
+void Cpu6502::Reset() {
+    pc_ = Read16(c_ResetVector);
+    sp_ = 0xFD;
+    p_ |= InterruptDisable;
+    nmi_pending_ = false;
+}
+
+std::uint8_t Cpu6502::Fetch() {
+    return bus_.Read(pc_++);
+}
+
+std::uint16_t Cpu6502::Fetch16() {
+    std::uint16_t const value{Read16(pc_)};
+    pc_ += 2;
+    return value;
+}
+
+std::uint16_t Cpu6502::Read16(std::uint16_t address) {
+    return static_cast<std::uint16_t>(bus_.Read(address) | bus_.Read(static_cast<std::uint16_t>(address + 1)) << 8);
+}
+
+std::uint16_t Cpu6502::Read16Wrapped(std::uint16_t address) {
+    auto const high{static_cast<std::uint16_t>((address & 0xFF00) | ((address + 1) & 0x00FF))};
+    return static_cast<std::uint16_t>(bus_.Read(address) | bus_.Read(high) << 8);
+}
+
+void Cpu6502::Push(std::uint8_t value) {
+    bus_.Write(static_cast<std::uint16_t>(0x0100 | sp_--), value);
+}
+
+std::uint8_t Cpu6502::Pull() {
+    return bus_.Read(static_cast<std::uint16_t>(0x0100 | ++sp_));
+}
+
+void Cpu6502::Interrupt(std::uint16_t vector, bool software) {
+    Push(static_cast<std::uint8_t>(pc_ >> 8));
+    Push(static_cast<std::uint8_t>(pc_));
+    Push(static_cast<std::uint8_t>(p_ | Unused | (software ? Break : 0)));
+    p_ |= InterruptDisable;
+    pc_ = Read16(vector);
+}
+
+void Cpu6502::SetFlag(Flag flag, bool set) noexcept {
+    p_ = static_cast<std::uint8_t>(set ? p_ | flag : p_ & ~flag);
+}
+
+bool Cpu6502::GetFlag(Flag flag) const noexcept {
+    return (p_ & flag) != 0;
+}
+
+std::uint8_t Cpu6502::SetZeroNegative(std::uint8_t value) noexcept {
+    SetFlag(Zero, value == 0);
+    SetFlag(Negative, (value & 0x80) != 0);
+    return value;
+}
+
+std::uint16_t Cpu6502::ZeroPage(std::uint8_t index) {
+    return static_cast<std::uint8_t>(Fetch() + index);
+}
+
+std::uint16_t Cpu6502::Absolute(std::uint8_t index, bool penalty) {
+    std::uint16_t const base{Fetch16()};
+    auto const address{static_cast<std::uint16_t>(base + index)};
+    if (penalty && CrossesPage(base, address))
+        ++extra_cycles_;
+    return address;
+}
+
+std::uint16_t Cpu6502::IndexedIndirect() {
+    return Read16Wrapped(ZeroPage(x_));
+}
+
+std::uint16_t Cpu6502::IndirectIndexed(bool penalty) {
+    std::uint16_t const base{Read16Wrapped(ZeroPage())};
+    auto const address{static_cast<std::uint16_t>(base + y_)};
+    if (penalty && CrossesPage(base, address))
+        ++extra_cycles_;
+    return address;
+}
+
+void Cpu6502::Branch(bool taken) {
+    auto const offset{static_cast<std::int8_t>(Fetch())};
+    if (!taken)
+        return;
+
+    auto const target{static_cast<std::uint16_t>(pc_ + offset)};
+    extra_cycles_ += CrossesPage(pc_, target) ? 2 : 1;
+    pc_ = target;
+}
+
+void Cpu6502::AddWithCarry(std::uint8_t value) noexcept {
+    unsigned const sum{a_ + value + (GetFlag(Carry) ? 1u : 0u)};
+    auto const result{static_cast<std::uint8_t>(sum)};
+    SetFlag(Carry, sum > 0xFF);
+    SetFlag(Overflow, ((a_ ^ result) & (value ^ result) & 0x80) != 0);
+    a_ = SetZeroNegative(result);
+}
+
+void Cpu6502::Compare(std::uint8_t register_value, std::uint8_t value) noexcept {
+    SetFlag(Carry, register_value >= value);
+    (void)SetZeroNegative(static_cast<std::uint8_t>(register_value - value));
+}
+
+// The opcodes ending in binary 01 encode the operation in their top three bits and the addressing mode in the middle
+// three.
+void Cpu6502::Alu(std::uint8_t operation, std::uint8_t mode) {
+    constexpr std::uint8_t c_Store{4};
+    constexpr std::uint8_t c_ImmediateMode{2};
+
+    if (operation == c_Store && mode == c_ImmediateMode) {
+        // An unofficial NOP with an operand.
+        (void)Fetch();
+        return;
+    }
+
+    bool const penalty{operation != c_Store};
+    std::uint16_t address{};
+    switch (mode) {
+    case 0: address = IndexedIndirect(); break;
+    case 1: address = ZeroPage(); break;
+    case 2: address = pc_++; break;
+    case 3: address = Absolute(); break;
+    case 4: address = IndirectIndexed(penalty); break;
+    case 5: address = ZeroPage(x_); break;
+    case 6: address = Absolute(y_, penalty); break;
+    default: address = Absolute(x_, penalty); break;
+    }
+
+    if (operation == c_Store) {
+        bus_.Write(address, a_);
+        return;
+    }
+
+    std::uint8_t const value{bus_.Read(address)};
+    switch (operation) {
+    case 0: a_ = SetZeroNegative(a_ | value); break;
+    case 1: a_ = SetZeroNegative(a_ & value); break;
+    case 2: a_ = SetZeroNegative(a_ ^ value); break;
+    case 3: AddWithCarry(value); break;
+    case 5: a_ = SetZeroNegative(value); break;
+    case 6: Compare(a_, value); break;
+    default: AddWithCarry(static_cast<std::uint8_t>(~value)); break;
+    }
+}
+
+std::uint8_t Cpu6502::Shift(std::uint8_t operation, std::uint8_t value) noexcept {
+    bool const carry_in{GetFlag(Carry)};
+    switch (operation) {
+    case 0:
+        SetFlag(Carry, (value & 0x80) != 0);
+        return SetZeroNegative(static_cast<std::uint8_t>(value << 1));
+    case 1:
+        SetFlag(Carry, (value & 0x80) != 0);
+        return SetZeroNegative(static_cast<std::uint8_t>(value << 1 | (carry_in ? 1 : 0)));
+    case 2:
+        SetFlag(Carry, (value & 0x01) != 0);
+        return SetZeroNegative(static_cast<std::uint8_t>(value >> 1));
+    default:
+        SetFlag(Carry, (value & 0x01) != 0);
+        return SetZeroNegative(static_cast<std::uint8_t>(value >> 1 | (carry_in ? 0x80 : 0)));
+    }
+}
+
+void Cpu6502::ShiftMemory(std::uint8_t operation, std::uint16_t address) {
+    bus_.Write(address, Shift(operation, bus_.Read(address)));
+}
+
+int Cpu6502::Step() {
+    if (nmi_pending_) {
+        nmi_pending_ = false;
+        Interrupt(c_NmiVector, false);
+        return 7;
+    }
+
+    std::uint8_t const opcode{Fetch()};
+    extra_cycles_ = 0;
+
+    if ((opcode & 0x03) == 0x01) {
+        Alu(static_cast<std::uint8_t>(opcode >> 5), static_cast<std::uint8_t>((opcode >> 2) & 0x07));
+        return c_Cycles[opcode] + extra_cycles_;
+    }
+
+    auto const shift{static_cast<std::uint8_t>(opcode >> 5)};
+    auto const read_modify_write{[&](std::uint16_t address, int delta) {
+        bus_.Write(address, SetZeroNegative(static_cast<std::uint8_t>(bus_.Read(address) + delta)));
+    }};
+
+    switch (opcode) {
+    // ASL, ROL, LSR, ROR
+    case 0x0A: case 0x2A: case 0x4A: case 0x6A: a_ = Shift(shift, a_); break;
+    case 0x06: case 0x26: case 0x46: case 0x66: ShiftMemory(shift, ZeroPage()); break;
+    case 0x16: case 0x36: case 0x56: case 0x76: ShiftMemory(shift, ZeroPage(x_)); break;
+    case 0x0E: case 0x2E: case 0x4E: case 0x6E: ShiftMemory(shift, Absolute()); break;
+    case 0x1E: case 0x3E: case 0x5E: case 0x7E: ShiftMemory(shift, Absolute(x_)); break;
+
+    // INC, DEC
+    case 0xE6: read_modify_write(ZeroPage(), 1); break;
+    case 0xF6: read_modify_write(ZeroPage(x_), 1); break;
+    case 0xEE: read_modify_write(Absolute(), 1); break;
+    case 0xFE: read_modify_write(Absolute(x_), 1); break;
+    case 0xC6: read_modify_write(ZeroPage(), -1); break;
+    case 0xD6: read_modify_write(ZeroPage(x_), -1); break;
+    case 0xCE: read_modify_write(Absolute(), -1); break;
+    case 0xDE: read_modify_write(Absolute(x_), -1); break;
+
+    // LDX, LDY, STX, STY
+    case 0xA2: x_ = SetZeroNegative(Fetch()); break;
+    case 0xA6: x_ = SetZeroNegative(bus_.Read(ZeroPage())); break;
+    case 0xB6: x_ = SetZeroNegative(bus_.Read(ZeroPage(y_))); break;
+    case 0xAE: x_ = SetZeroNegative(bus_.Read(Absolute())); break;
+    case 0xBE: x_ = SetZeroNegative(bus_.Read(Absolute(y_, true))); break;
+    case 0xA0: y_ = SetZeroNegative(Fetch()); break;
+    case 0xA4: y_ = SetZeroNegative(bus_.Read(ZeroPage())); break;
+    case 0xB4: y_ = SetZeroNegative(bus_.Read(ZeroPage(x_))); break;
+    case 0xAC: y_ = SetZeroNegative(bus_.Read(Absolute())); break;
+    case 0xBC: y_ = SetZeroNegative(bus_.Read(Absolute(x_, true))); break;
+    case 0x86: bus_.Write(ZeroPage(), x_); break;
+    case 0x96: bus_.Write(ZeroPage(y_), x_); break;
+    case 0x8E: bus_.Write(Absolute(), x_); break;
+    case 0x84: bus_.Write(ZeroPage(), y_); break;
+    case 0x94: bus_.Write(ZeroPage(x_), y_); break;
+    case 0x8C: bus_.Write(Absolute(), y_); break;
+
+    // CPX, CPY, BIT
+    case 0xE0: Compare(x_, Fetch()); break;
+    case 0xE4: Compare(x_, bus_.Read(ZeroPage())); break;
+    case 0xEC: Compare(x_, bus_.Read(Absolute())); break;
+    case 0xC0: Compare(y_, Fetch()); break;
+    case 0xC4: Compare(y_, bus_.Read(ZeroPage())); break;
+    case 0xCC: Compare(y_, bus_.Read(Absolute())); break;
+    case 0x24:
+    case 0x2C: {
+        std::uint8_t const value{bus_.Read(opcode == 0x24 ? ZeroPage() : Absolute())};
+        SetFlag(Zero, (a_ & value) == 0);
+        SetFlag(Overflow, (value & 0x40) != 0);
+        SetFlag(Negative, (value & 0x80) != 0);
+        break;
+    }
+
+    // Register transfers and increments
+    case 0xAA: x_ = SetZeroNegative(a_); break;
+    case 0xA8: y_ = SetZeroNegative(a_); break;
+    case 0x8A: a_ = SetZeroNegative(x_); break;
+    case 0x98: a_ = SetZeroNegative(y_); break;
+    case 0xBA: x_ = SetZeroNegative(sp_); break;
+    case 0x9A: sp_ = x_; break;
+    case 0xE8: x_ = SetZeroNegative(static_cast<std::uint8_t>(x_ + 1)); break;
+    case 0xC8: y_ = SetZeroNegative(static_cast<std::uint8_t>(y_ + 1)); break;
+    case 0xCA: x_ = SetZeroNegative(static_cast<std::uint8_t>(x_ - 1)); break;
+    case 0x88: y_ = SetZeroNegative(static_cast<std::uint8_t>(y_ - 1)); break;
+
+    // Stack
+    case 0x48: Push(a_); break;
+    case 0x08: Push(static_cast<std::uint8_t>(p_ | Break | Unused)); break;
+    case 0x68: a_ = SetZeroNegative(Pull()); break;
+    case 0x28: p_ = static_cast<std::uint8_t>((Pull() & ~Break) | Unused); break;
+
+    // Flags
+    case 0x18: SetFlag(Carry, false); break;
+    case 0x38: SetFlag(Carry, true); break;
+    case 0x58: SetFlag(InterruptDisable, false); break;
+    case 0x78: SetFlag(InterruptDisable, true); break;
+    case 0xB8: SetFlag(Overflow, false); break;
+    case 0xD8: SetFlag(Decimal, false); break;
+    case 0xF8: SetFlag(Decimal, true); break;
+
+    // Branches
+    case 0x10: Branch(!GetFlag(Negative)); break;
+    case 0x30: Branch(GetFlag(Negative)); break;
+    case 0x50: Branch(!GetFlag(Overflow)); break;
+    case 0x70: Branch(GetFlag(Overflow)); break;
+    case 0x90: Branch(!GetFlag(Carry)); break;
+    case 0xB0: Branch(GetFlag(Carry)); break;
+    case 0xD0: Branch(!GetFlag(Zero)); break;
+    case 0xF0: Branch(GetFlag(Zero)); break;
+
+    // Jumps and interrupts
+    case 0x4C: pc_ = Fetch16(); break;
+    case 0x6C: pc_ = Read16Wrapped(Fetch16()); break;
+    case 0x20: {
+        std::uint16_t const target{Fetch16()};
+        auto const return_address{static_cast<std::uint16_t>(pc_ - 1)};
+        Push(static_cast<std::uint8_t>(return_address >> 8));
+        Push(static_cast<std::uint8_t>(return_address));
+        pc_ = target;
+        break;
+    }
+    case 0x60: {
+        std::uint8_t const low{Pull()};
+        pc_ = static_cast<std::uint16_t>((low | Pull() << 8) + 1);
+        break;
+    }
+    case 0x40: {
+        p_ = static_cast<std::uint8_t>((Pull() & ~Break) | Unused);
+        std::uint8_t const low{Pull()};
+        pc_ = static_cast<std::uint16_t>(low | Pull() << 8);
+        break;
+    }
+    case 0x00:
+        ++pc_;
+        Interrupt(c_IrqVector, true);
+        break;
+
+    default:
+        break;
+    }
+
+    return c_Cycles[opcode] + extra_cycles_;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+
+// The memory the CPU sees. Reads can have side effects, the PPU status register clears its flags when read.
+class CpuBus {
+public:
+    virtual ~CpuBus() = default;
+
+    virtual std::uint8_t Read(std::uint16_t address) = 0;
+    virtual void Write(std::uint16_t address, std::uint8_t value) = 0;
+};
+
+// The 2A03's 6502 core: every official opcode, no decimal mode. Timing is per instruction, with the page crossing and
+// taken branch penalties, which is close enough for software that waits on vblank rather than counting cycles.
+// Unofficial opcodes run as one-byte NOPs.
+class Cpu6502 final {
+public:
+    explicit Cpu6502(CpuBus &bus) noexcept
+        : bus_{bus} {
+    }
+
+    void Reset();
+
+    // Taken before the next instruction.
+    void RequestNmi() noexcept {
+        nmi_pending_ = true;
+    }
+
+    // Runs one instruction, or enters a pending interrupt, and returns the cycles it took.
+    int Step();
+
+    [[nodiscard]]
+    std::uint16_t ProgramCounter() const noexcept {
+        return pc_;
+    }
+
+private:
+    enum Flag : std::uint8_t {
+        Carry = 1 << 0,
+        Zero = 1 << 1,
+        InterruptDisable = 1 << 2,
+        Decimal = 1 << 3,
+        Break = 1 << 4,
+        Unused = 1 << 5,
+        Overflow = 1 << 6,
+        Negative = 1 << 7
+    };
+
+    CpuBus &bus_;
+    std::uint16_t pc_{0};
+    std::uint8_t a_{0};
+    std::uint8_t x_{0};
+    std::uint8_t y_{0};
+    std::uint8_t sp_{0xFD};
+    std::uint8_t p_{InterruptDisable | Unused};
+    bool nmi_pending_{false};
+    // Added to the instruction's base cycles by page crossings and taken branches.
+    int extra_cycles_{0};
+
+    [[nodiscard]]
+    std::uint8_t Fetch();
+    [[nodiscard]]
+    std::uint16_t Fetch16();
+    [[nodiscard]]
+    std::uint16_t Read16(std::uint16_t address);
+    // The high byte comes from the same page, as with JMP ($xxFF) and zero page pointers.
+    [[nodiscard]]
+    std::uint16_t Read16Wrapped(std::uint16_t address);
+
+    void Push(std::uint8_t value);
+    [[nodiscard]]
+    std::uint8_t Pull();
+    void Interrupt(std::uint16_t vector, bool software);
+
+    void SetFlag(Flag flag, bool set) noexcept;
+    [[nodiscard]]
+    bool GetFlag(Flag flag) const noexcept;
+    std::uint8_t SetZeroNegative(std::uint8_t value) noexcept;
+
+    // Effective addresses. `penalty` adds the cycle reads pay when indexing crosses a page.
+    [[nodiscard]]
+    std::uint16_t ZeroPage(std::uint8_t index = 0);
+    [[nodiscard]]
+    std::uint16_t Absolute(std::uint8_t index = 0, bool penalty = false);
+    [[nodiscard]]
+    std::uint16_t IndexedIndirect();
+    [[nodiscard]]
+    std::uint16_t IndirectIndexed(bool penalty);
+
+    void Branch(bool taken);
+    void AddWithCarry(std::uint8_t value) noexcept;
+    void Compare(std::uint8_t register_value, std::uint8_t value) noexcept;
+    void Alu(std::uint8_t operation, std::uint8_t mode);
+
+    // ASL, ROL, LSR and ROR by the opcode's top three bits.
+    std::uint8_t Shift(std::uint8_t operation, std::uint8_t value) noexcept;
+    void ShiftMemory(std::uint8_t operation, std::uint16_t address);
+};
@@ -0,0 +1,133 @@
+#include "deck.h"
+
+#include <algorithm>
+#include <cassert>
+#include <format>
+#include <numeric>
+#include <span>
+
+Deck::Deck() {
+    Replaced();
+}
+
+void Deck::Replaced() {
+    if (storage_.slides.empty())
+        storage_.slides.emplace_back();
+
+    ids_.resize(storage_.slides.size());
+    for (auto &id : ids_)
+        id = next_id_++;
+
+    snapshot_ = SnapshotDeck(storage_.slides, ids_);
+    metrics_.Assign(storage_.slides);
+    index_.Assign(storage_.slides, ids_);
+}
+
+void Deck::Edited(std::size_t index) {
+    snapshot_.Set(index, SnapshotSlide(ids_[index], storage_.slides[index]));
+    metrics_.Update(index, storage_.slides[index]);
+    index_.Update(ids_[index], storage_.slides[index]);
+}
+
+std::size_t Deck::Insert(std::size_t index, SlideGrid const &slide) {
+    assert(index <= Size());
+
+    auto const offset{static_cast<std::ptrdiff_t>(index)};
+    storage_.slides.insert(storage_.slides.begin() + offset, slide);
+    ids_.insert(ids_.begin() + offset, next_id_);
+    snapshot_.Insert(index, SnapshotSlide(next_id_, slide));
+    metrics_.Insert(index, slide);
+    index_.Insert(next_id_, slide);
+    ++next_id_;
+    return index;
+}
+
+void Deck::Erase(std::size_t index) {
+    assert(index < Size());
+
+    index_.Erase(ids_[index]);
+    auto const offset{static_cast<std::ptrdiff_t>(index)};
+    storage_.slides.erase(storage_.slides.begin() + offset);
+    ids_.erase(ids_.begin() + offset);
+    snapshot_.Erase(index);
+    metrics_.Erase(index);
+}
+
+std::size_t Deck::Duplicate(std::size_t first, std::size_t count) {
+    assert(first + count <= Size());
+
+    // Inserted blank first, copying from a range of the vector into itself is not allowed.
+    auto const to{first + count};
+    auto &slides{storage_.slides};
+    slides.insert(slides.begin() + static_cast<std::ptrdiff_t>(to), count, SlideGrid{});
+    std::copy_n(slides.begin() + static_cast<std::ptrdiff_t>(first), count, slides.begin() + static_cast<std::ptrdiff_t>(to));
+
+    auto const first_id{next_id_};
+    ids_.insert(ids_.begin() + static_cast<std::ptrdiff_t>(to), count, SlideId{});
+    std::iota(ids_.begin() + static_cast<std::ptrdiff_t>(to), ids_.begin() + static_cast<std::ptrdiff_t>(to + count), first_id);
+    next_id_ += static_cast<SlideId>(count);
+
+    std::vector<SlideSnapshot> copies;
+    copies.reserve(count);
+    snapshot_.ForEach(first, count, [&](std::size_t index, SlideSnapshot const &slide) {
+        copies.push_back({ids_[to + index - first], slide.grid});
+    });
+    snapshot_.InsertRange(to, std::move(copies));
+
+    std::span<SlideGrid const> const inserted{slides.data() + to, count};
+    metrics_.Insert(to, inserted);
+    for (std::size_t i{0}; i < count; ++i)
+        index_.Insert(ids_[to + i], inserted[i]);
+
+    return to;
+}
+
+void Deck::Move(std::size_t from, std::size_t to, std::size_t count) {
+    assert(from + count <= Size() && to + count <= Size());
+    if (from == to || count == 0)
+        return;
+
+    MoveBlock(storage_.slides, from, to, count);
+    MoveBlock(ids_, from, to, count);
+    metrics_.Move(from, to, count);
+    snapshot_.Move(from, to, count);
+}
+
+void Deck::Clear() {
+    storage_.arena.Reset(storage_.slides, 1);
+    Replaced();
+}
+
+bool Deck::Restore(DeckSnapshot const &target) {
+    bool const resized{target.size() != snapshot_.size()};
+
+    if (!resized) {
+        // Undoing a move swaps ids between slides, so every slide leaves the index before any comes back.
+        std::vector<std::size_t> changed;
+        target.ForEachDifference(snapshot_, [&](std::size_t index, SlideSnapshot const &slide) {
+            index_.Erase(ids_[index]);
+            storage_.slides[index] = *slide.grid;
+            ids_[index] = slide.id;
+            metrics_.Update(index, storage_.slides[index]);
+            changed.push_back(index);
+        });
+        for (auto const index : changed)
+            index_.Insert(ids_[index], storage_.slides[index]);
+    } else {
+        storage_.arena.Reset(storage_.slides, target.size());
+        ids_.clear();
+        target.ForEach([&](std::size_t, SlideSnapshot const &slide) {
+            storage_.slides.push_back(*slide.grid);
+            ids_.push_back(slide.id);
+        });
+        metrics_.Assign(storage_.slides);
+        index_.Assign(storage_.slides, ids_);
+    }
+
+    snapshot_ = target;
+    return resized;
+}
+
+std::string Deck::Title(std::size_t index) {
+    return std::format("Slide {}", index);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "deck_arena.h"
+#include "deck_metrics.h"
+#include "search_index.h"
+#include "slide_snapshot.h"
+
+// The deck being edited. Slides stay contiguous and in order in their arena, each paired with a stable id, and a
+// snapshot, the metrics and the search index of the deck are kept in step with every change. All changes go through
+// here so they never disagree.
+class Deck final {
+public:
+    Deck();
+
+    Deck(Deck const &) = delete;
+    Deck &operator=(Deck const &) = delete;
+
+    [[nodiscard]]
+    std::size_t Size() const noexcept {
+        return storage_.slides.size();
+    }
+
+    [[nodiscard]]
+    SlideGrid const &operator[](std::size_t index) const noexcept {
+        return storage_.slides[index];
+    }
+
+    [[nodiscard]]
+    SlideId Id(std::size_t index) const noexcept {
+        return ids_[index];
+    }
+
+    [[nodiscard]]
+    DeckSnapshot const &Snapshot() const noexcept {
+        return snapshot_;
+    }
+
+    [[nodiscard]]
+    DeckMetrics const &Metrics() const noexcept {
+        return metrics_;
+    }
+
+    [[nodiscard]]
+    SearchIndex const &Index() const noexcept {
+        return index_;
+    }
+
+    // For loaders that replace every slide at once, which must call Replaced() afterwards.
+    [[nodiscard]]
+    DeckStorage &Storage() noexcept {
+        return storage_;
+    }
+
+    // Gives every slide a new id and retakes the snapshot. A deck left empty gets one blank slide.
+    void Replaced();
+
+    // Brings the snapshot, metrics and index up to date after the slide at the index was edited in place.
+    void Edited(std::size_t index);
+
+    std::size_t Insert(std::size_t index, SlideGrid const &slide = {});
+    void Erase(std::size_t index);
+
+    // Inserts copies of the block right after it and returns where the copies start. The copies get new ids but share
+    // their snapshot grids with the originals until either is edited. Costs the slides after the block plus the copies.
+    std::size_t Duplicate(std::size_t first, std::size_t count = 1);
+
+    // Moves the block of `count` slides at `from` so that it starts at `to`. Costs the slides moved over and the block
+    // itself, so moving one slide by one is a swap. The snapshot only rotates leaf pointers.
+    void Move(std::size_t from, std::size_t to, std::size_t count = 1);
+
+    // Drops every slide but a blank one.
+    void Clear();
+
+    // Makes the deck match `target`, copying only the slides that differ from the current snapshot when the slide count
+    // is unchanged. Returns whether slides were added or removed.
+    bool Restore(DeckSnapshot const &target);
+
+    // Formatted on demand, only the titles on screen are ever built.
+    [[nodiscard]]
+    static std::string Title(std::size_t index);
+
+private:
+    DeckStorage storage_;
+    std::vector<SlideId> ids_;
+    SlideId next_id_{0};
+    DeckSnapshot snapshot_;
+    DeckMetrics metrics_;
+    SearchIndex index_;
+};
@@ -0,0 +1,60 @@
+#include "deck_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+    // Room for the monotonic resource's own bookkeeping, so a reservation still fits in the first block.
+    constexpr std::size_t c_ArenaSlack{4 * alignof(std::max_align_t)};
+}
+
+DeckArena::DeckArena()
+    : arena_{MakeArena(0)} {
+}
+
+std::unique_ptr<std::pmr::monotonic_buffer_resource> DeckArena::MakeArena(std::size_t capacity) {
+    return std::make_unique<std::pmr::monotonic_buffer_resource>(std::max<std::size_t>(capacity, 1) * sizeof(SlideGrid) + c_ArenaSlack, &upstream_);
+}
+
+void DeckArena::Reset(Slides &slides, std::size_t capacity) {
+    // The old buffer is handed back to this arena, which ignores deallocations, before its memory goes away.
+    Slides(this).swap(slides);
+    arena_ = MakeArena(capacity);
+
+    if (capacity != 0)
+        slides.reserve(capacity);
+}
+
+void DeckArena::Compact(Slides &slides) {
+    auto const previous_arena{std::move(arena_)};
+    arena_ = MakeArena(slides.size());
+
+    Slides compacted(this);
+    compacted.reserve(slides.size());
+    compacted.assign(slides.begin(), slides.end());
+    slides.swap(compacted);
+}
+
+void *DeckArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    return arena_->allocate(bytes, alignment);
+}
+
+void DeckArena::do_deallocate(void *, std::size_t, std::size_t) {
+}
+
+bool DeckArena::do_is_equal(memory_resource const &other) const noexcept {
+    return this == &other;
+}
+
+void *DeckArena::CountingResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    ++count_;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void DeckArena::CountingResource::do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+}
+
+bool DeckArena::CountingResource::do_is_equal(memory_resource const &other) const noexcept {
+    return this == &other;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+
+#include "slides.h"
+
+// Backs the slides of one deck with a monotonic arena. Loading a deck makes one upstream allocation sized for it and
+// replacing the deck frees the whole arena at once. Slides added while editing grow the vector inside the arena, the
+// outgrown buffers are only reclaimed by Compact().
+//
+// The arena forwards to a replaceable monotonic resource, so a vector using it keeps a stable allocator while the
+// memory underneath is swapped out.
+class DeckArena final : public std::pmr::memory_resource {
+public:
+    DeckArena();
+
+    // Drops the slides, frees the arena and reserves room for `capacity` slides in a single allocation.
+    void Reset(Slides &slides, std::size_t capacity = 0);
+
+    // Moves the slides into a fresh arena of exactly their size and frees the previous one.
+    void Compact(Slides &slides);
+
+    [[nodiscard]]
+    std::size_t UpstreamAllocations() const noexcept {
+        return upstream_allocations_;
+    }
+
+private:
+    // Counts the blocks the monotonic arena asks for, everything else comes out of those blocks.
+    class CountingResource final : public std::pmr::memory_resource {
+    public:
+        explicit CountingResource(std::size_t &count)
+            : count_{count} {
+        }
+
+    private:
+        std::size_t &count_;
+
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+        [[nodiscard]]
+        bool do_is_equal(memory_resource const &other) const noexcept override;
+    };
+
+    std::size_t upstream_allocations_{0};
+    CountingResource upstream_{upstream_allocations_};
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena_;
+
+    [[nodiscard]]
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> MakeArena(std::size_t capacity);
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+    [[nodiscard]]
+    bool do_is_equal(memory_resource const &other) const noexcept override;
+};
+
+// A deck whose slides live in their own arena. Neither is movable, the slides hold a pointer to the arena.
+struct DeckStorage final {
+    DeckArena arena;
+    Slides slides{&arena};
+};
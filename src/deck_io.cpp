@@ -0,0 +1,94 @@
+#include "deck_io.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "trace.h"
+
+std::size_t CountSlides(std::string_view bytes) noexcept {
+    return static_cast<std::size_t>(std::ranges::count(bytes, '\0'));
+}
+
+std::size_t ParseSlides(std::string_view bytes, Slides &out) {
+    out.clear();
+    out.reserve(CountSlides(bytes));
+
+    std::size_t damaged{0};
+    for (auto terminator{bytes.find('\0')}; terminator != std::string_view::npos; terminator = bytes.find('\0')) {
+        damaged += out.emplace_back().AssignText(bytes.substr(0, terminator)) ? 0 : 1;
+        bytes.remove_prefix(terminator + 1);
+    }
+
+    return damaged;
+}
+
+std::string SerializeSlides(Slides const &slides) {
+    std::size_t size{0};
+    for (auto const &slide : slides)
+        size += slide.TextSize() + 1;
+
+    std::string bytes;
+    bytes.reserve(size);
+    for (auto const &slide : slides) {
+        bytes.append(slide.Text());
+        bytes.push_back('\0');
+    }
+
+    return bytes;
+}
+
+bool ReadFile(std::filesystem::path const &path, std::string &out) {
+    NESLIDES_TRACE("io", "ReadFile", path.string());
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+
+    if (!file.is_open())
+        return false;
+
+    out.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+
+    return static_cast<bool>(file.read(out.data(), static_cast<std::streamsize>(out.size())));
+}
+
+bool WriteFile(std::filesystem::path const &path, std::string_view bytes) {
+    NESLIDES_TRACE("io", "WriteFile", path.string());
+    std::ofstream file{path, std::ios::binary};
+
+    if (!file.is_open())
+        return false;
+
+    return static_cast<bool>(file.write(bytes.data(), static_cast<std::streamsize>(bytes.size())));
+}
+
+bool ReadSlidesFile(std::filesystem::path const &path, Slides &out, std::size_t &damaged) {
+    std::string bytes;
+    if (!ReadFile(path, bytes))
+        return false;
+
+    damaged = ParseSlides(bytes, out);
+    return true;
+}
+
+bool WriteSlidesFile(std::filesystem::path const &path, Slides const &slides) {
+    return WriteFile(path, SerializeSlides(slides));
+}
+
+std::vector<std::filesystem::path> CollectDecks(std::span<std::string_view const> inputs) {
+    std::vector<std::filesystem::path> decks;
+    std::error_code error;
+
+    for (auto const input : inputs) {
+        std::filesystem::path const path{input};
+        if (!std::filesystem::is_directory(path, error)) {
+            decks.emplace_back(path);
+            continue;
+        }
+
+        for (auto const &entry : std::filesystem::directory_iterator{path, error}) {
+            if (entry.is_regular_file(error) && entry.path().extension() == c_DeckExtension)
+                decks.emplace_back(entry.path());
+        }
+    }
+
+    return decks;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "slides.h"
+
+constexpr std::string_view c_DeckExtension{".neslides"};
+
+// A .neslides file is every slide's text followed by a NUL terminator. Text that does not fit a slide's grid, and
+// characters a slide cannot hold, are dropped when parsed and the slides they were dropped from are counted.
+[[nodiscard]]
+std::size_t CountSlides(std::string_view bytes) noexcept;
+
+// Replaces the contents of `out`, reserving room for every slide once up front. Returns the number of slides that lost
+// text, see SlideGrid::AssignText.
+[[nodiscard]]
+std::size_t ParseSlides(std::string_view bytes, Slides &out);
+
+[[nodiscard]]
+std::string SerializeSlides(Slides const &slides);
+
+[[nodiscard]]
+bool ReadFile(std::filesystem::path const &path, std::string &out);
+
+[[nodiscard]]
+bool WriteFile(std::filesystem::path const &path, std::string_view bytes);
+
+// `damaged` is set to the number of slides that lost text, see ParseSlides.
+[[nodiscard]]
+bool ReadSlidesFile(std::filesystem::path const &path, Slides &out, std::size_t &damaged);
+
+[[nodiscard]]
+bool WriteSlidesFile(std::filesystem::path const &path, Slides const &slides);
+
+// Every input that is not a directory as it is, and the decks directly inside the ones that are.
+[[nodiscard]]
+std::vector<std::filesystem::path> CollectDecks(std::span<std::string_view const> inputs);
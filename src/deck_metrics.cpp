@@ -0,0 +1,70 @@
+#include "deck_metrics.h"
+
+#include <algorithm>
+#include <span>
+
+#include "export.h"
+
+SlideMetrics MeasureSlide(SlideGrid const &slide) {
+    auto const lengths{std::span{slide.row_lengths}.first(static_cast<std::size_t>(slide.row_count))};
+
+    int const screen_rows{ScreenRowCount(slide)};
+    return {
+        screen_rows,
+        *std::ranges::max_element(lengths),
+        EncodedSize(slide),
+        screen_rows > c_MaxSlideLines
+    };
+}
+
+void DeckMetrics::Assign(Slides const &slides) {
+    slides_.clear();
+    slides_.reserve(slides.size());
+    totals_ = {};
+
+    for (auto const &slide : slides) {
+        slides_.push_back(MeasureSlide(slide));
+        Count(slides_.back());
+    }
+}
+
+void DeckMetrics::Update(std::size_t index, SlideGrid const &slide) {
+    Uncount(slides_[index]);
+    slides_[index] = MeasureSlide(slide);
+    Count(slides_[index]);
+}
+
+void DeckMetrics::Insert(std::size_t index, SlideGrid const &slide) {
+    auto const &metrics{*slides_.insert(slides_.begin() + static_cast<std::ptrdiff_t>(index), MeasureSlide(slide))};
+    Count(metrics);
+}
+
+void DeckMetrics::Insert(std::size_t index, std::span<SlideGrid const> slides) {
+    std::vector<SlideMetrics> measured;
+    measured.reserve(slides.size());
+    for (auto const &slide : slides)
+        Count(measured.emplace_back(MeasureSlide(slide)));
+
+    slides_.insert(slides_.begin() + static_cast<std::ptrdiff_t>(index), measured.begin(), measured.end());
+}
+
+void DeckMetrics::Erase(std::size_t index) {
+    Uncount(slides_[index]);
+    slides_.erase(slides_.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+void DeckMetrics::Move(std::size_t from, std::size_t to, std::size_t count) {
+    MoveBlock(slides_, from, to, count);
+}
+
+void DeckMetrics::Count(SlideMetrics const &metrics) {
+    totals_.rows += static_cast<std::size_t>(metrics.rows);
+    totals_.encoded_size += metrics.encoded_size;
+    totals_.overflowing_slides += metrics.overflows;
+}
+
+void DeckMetrics::Uncount(SlideMetrics const &metrics) {
+    totals_.rows -= static_cast<std::size_t>(metrics.rows);
+    totals_.encoded_size -= metrics.encoded_size;
+    totals_.overflowing_slides -= metrics.overflows;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "slides.h"
+
+// Moves the block of `count` elements at `from` so that it starts at `to`, shifting the elements in between.
+template<typename Range>
+void MoveBlock(Range &range, std::size_t from, std::size_t to, std::size_t count) {
+    auto const at{[&](std::size_t index) {
+        return range.begin() + static_cast<std::ptrdiff_t>(index);
+    }};
+
+    if (to < from)
+        std::rotate(at(to), at(from), at(from + count));
+    else
+        std::rotate(at(from), at(from + count), at(to + count));
+}
+
+struct SlideMetrics final {
+    // Rows of the screen the slide takes, see ScreenRowCount.
+    int rows{};
+    int longest_row{};
+    // Bytes the slide takes in the ROM.
+    std::size_t encoded_size{};
+    // Whether the slide runs into the row the NES screen keeps free, past c_MaxSlideLines.
+    bool overflows{};
+
+    bool operator==(SlideMetrics const &) const = default;
+};
+
+[[nodiscard]]
+SlideMetrics MeasureSlide(SlideGrid const &slide);
+
+struct DeckTotals final {
+    std::size_t rows{};
+    std::size_t encoded_size{};
+    std::size_t overflowing_slides{};
+
+    bool operator==(DeckTotals const &) const = default;
+};
+
+// The metrics of every slide of a deck and their totals, updated slide by slide as the deck changes so that reading
+// either never touches the slides.
+class DeckMetrics final {
+public:
+    [[nodiscard]]
+    SlideMetrics const &operator[](std::size_t index) const noexcept {
+        return slides_[index];
+    }
+
+    [[nodiscard]]
+    DeckTotals const &Totals() const noexcept {
+        return totals_;
+    }
+
+    void Assign(Slides const &slides);
+    void Update(std::size_t index, SlideGrid const &slide);
+    void Insert(std::size_t index, SlideGrid const &slide);
+    void Insert(std::size_t index, std::span<SlideGrid const> slides);
+    void Erase(std::size_t index);
+    void Move(std::size_t from, std::size_t to, std::size_t count = 1);
+
+private:
+    std::vector<SlideMetrics> slides_;
+    DeckTotals totals_;
+
+    void Count(SlideMetrics const &metrics);
+    void Uncount(SlideMetrics const &metrics);
+};
@@ -0,0 +1,127 @@
+#include "emulator_view.h"
+
+#include <algorithm>
+#include <bit>
+
+#include <ftxui/component/animation.hpp>
+#include <ftxui/dom/canvas.hpp>
+#include <ftxui/dom/elements.hpp>
+
+namespace {
+    constexpr std::chrono::nanoseconds c_FrameDuration{16'639'267};
+    // Frames run per redraw at most, a stalled terminal should not make the emulator try to catch up for seconds.
+    constexpr int c_MaxFramesPerRedraw{4};
+    constexpr int c_ButtonHoldFrames{6};
+
+    // The 2C02's colours as sRGB.
+    constexpr std::array<std::uint32_t, 64> c_NesColors{
+        0x666666, 0x002A88, 0x1412A7, 0x3B00A4, 0x5C007E, 0x6E0040, 0x6C0600, 0x561D00,
+        0x333500, 0x0B4800, 0x005200, 0x004F08, 0x00404D, 0x000000, 0x000000, 0x000000,
+        0xADADAD, 0x155FD9, 0x4240FF, 0x7527FE, 0xA01ACC, 0xB71E7B, 0xB53120, 0x994E00,
+        0x6B6D00, 0x388700, 0x0C9300, 0x008F32, 0x007C8D, 0x000000, 0x000000, 0x000000,
+        0xFFFEFF, 0x64B0FF, 0x9290FF, 0xC676FF, 0xF36AFF, 0xFE6ECC, 0xFE8170, 0xEA9E22,
+        0xBCBE00, 0x88D800, 0x5CE430, 0x45E082, 0x48CDDE, 0x4F4F4F, 0x000000, 0x000000,
+        0xFFFEFF, 0xC0DFFF, 0xD3D2FF, 0xE8C8FF, 0xFBC2FF, 0xFEC4EA, 0xFECCC5, 0xF7D8A5,
+        0xE4E594, 0xCFEF96, 0xBDF4AB, 0xB3F3CC, 0xB5EBF2, 0xB8B8B8, 0x000000, 0x000000
+    };
+
+    [[nodiscard]]
+    ftxui::Color NesColor(std::uint8_t color) {
+        std::uint32_t const rgb{c_NesColors[color & 0x3F]};
+        return ftxui::Color::RGB(static_cast<std::uint8_t>(rgb >> 16), static_cast<std::uint8_t>(rgb >> 8), static_cast<std::uint8_t>(rgb));
+    }
+}
+
+EmulatorView::EmulatorView(std::function<void()> on_close)
+    : on_close_{std::move(on_close)} {
+}
+
+bool EmulatorView::Boot(std::string_view rom) {
+    if (!nes_.Load(rom))
+        return false;
+
+    held_.fill(0);
+    next_frame_ = Clock::now();
+    return true;
+}
+
+void EmulatorView::RunDueFrames() {
+    auto const now{Clock::now()};
+    for (int frames{0}; next_frame_ <= now && frames < c_MaxFramesPerRedraw; ++frames) {
+        std::uint8_t buttons{0};
+        for (std::size_t button{0}; button < held_.size(); ++button) {
+            if (held_[button] > 0) {
+                --held_[button];
+                buttons |= static_cast<std::uint8_t>(1u << button);
+            }
+        }
+
+        nes_.SetButtons(buttons);
+        nes_.RunFrame();
+        next_frame_ += c_FrameDuration;
+    }
+
+    next_frame_ = std::max(next_frame_, now);
+}
+
+ftxui::Element EmulatorView::Render() {
+    using namespace ftxui;
+
+    RunDueFrames();
+
+    auto const &picture{nes_.Picture()};
+    std::uint8_t const backdrop{nes_.Backdrop()};
+
+    Canvas canvas{c_NesWidth, c_NesHeight / 2};
+    for (int y{0}; y < c_NesHeight; y += 2) {
+        for (int x{0}; x < c_NesWidth; ++x) {
+            std::uint8_t color{picture[static_cast<std::size_t>(y * c_NesWidth + x)]};
+            if (color == backdrop)
+                color = picture[static_cast<std::size_t>((y + 1) * c_NesWidth + x)];
+            if (color != backdrop)
+                canvas.DrawPoint(x, y / 2, true, NesColor(color));
+        }
+    }
+
+    animation::RequestAnimationFrame();
+
+    return window(text("ROM"), vbox({
+        ftxui::canvas(std::move(canvas)),
+        separator(),
+        text("Arrows: D-pad, Z: B, X: A, Return: Start, Tab: Select, Escape: close") | dim
+    }));
+}
+
+bool EmulatorView::OnEvent(ftxui::Event event) {
+    using ftxui::Event;
+
+    if (event == Event::Escape) {
+        if (on_close_)
+            on_close_();
+        return true;
+    }
+
+    std::uint8_t button{0};
+    if (event == Event::ArrowUp)
+        button = NesButtonUp;
+    else if (event == Event::ArrowDown)
+        button = NesButtonDown;
+    else if (event == Event::ArrowLeft)
+        button = NesButtonLeft;
+    else if (event == Event::ArrowRight)
+        button = NesButtonRight;
+    else if (event == Event::Return)
+        button = NesButtonStart;
+    else if (event == Event::Tab)
+        button = NesButtonSelect;
+    else if (event == Event::Character('z') || event == Event::Character('Z'))
+        button = NesButtonB;
+    else if (event == Event::Character('x') || event == Event::Character('X'))
+        button = NesButtonA;
+
+    if (button == 0)
+        return false;
+
+    held_[static_cast<std::size_t>(std::countr_zero(button))] = c_ButtonHoldFrames;
+    return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <string_view>
+
+#include <ftxui/component/component_base.hpp>
+#include <ftxui/component/event.hpp>
+
+#include "nes.h"
+
+// Runs a ROM in the built-in emulator at the NES frame rate and shows its picture in braille, one cell per 2x4 pixels
+// after folding pixel rows in pairs. Arrows are the D-pad, Z and X are B and A, Return is Start and Tab is Select.
+// Escape calls `on_close`.
+//
+// Terminals report key presses but not releases, so a press holds its button for a few frames.
+class EmulatorView final : public ftxui::ComponentBase {
+public:
+    explicit EmulatorView(std::function<void()> on_close);
+
+    // Loads the ROM and resets. Returns false if it is not an NROM image.
+    [[nodiscard]]
+    bool Boot(std::string_view rom);
+
+    ftxui::Element Render() override;
+    bool OnEvent(ftxui::Event event) override;
+
+    [[nodiscard]]
+    bool Focusable() const override {
+        return true;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Nes nes_;
+    std::function<void()> on_close_;
+    Clock::time_point next_frame_;
+    // Frames each button stays pressed, by bit of NesButton.
+    std::array<int, 8> held_{};
+
+    void RunDueFrames();
+};
@@ -0,0 +1,214 @@
+#include "export.h"
+
+#include <array>
+#include <fstream>
+#include <span>
+#include <sstream>
+
+#include "deck_io.h"
+#include "hash.h"
+#include "subprocess.h"
+#include "trace.h"
+
+namespace {
+    [[nodiscard]]
+    bool start_process(std::span<char const *> command) {
+        subprocess_s subprocess{};
+        if (int const result{subprocess_create(command.data(), subprocess_option_inherit_environment, &subprocess)}; result != 0) {
+            return false;
+        }
+
+        int process_return{};
+        if (const int result{subprocess_join(&subprocess, &process_return)}; result != 0) {
+            return false;
+        }
+
+        return true;
+    }
+
+    [[nodiscard]]
+    std::string EncodeSlide(SlideGrid const &slide) {
+        std::stringstream stream;
+        int const row_count{EncodedRowCount(slide)};
+
+        for (int row{0}; row < row_count; ++row) {
+            stream << ".byte ";
+            stream << (slide.IsBigText(row) ? "BIG_TEXT, " : "");
+            for (char const c : slide.Row(row))
+                stream << toupper(c) << ", ";
+
+            stream << "NEWLINE\n";
+        }
+
+        return stream.str();
+    }
+
+    [[nodiscard]]
+    bool WritePatch(std::string_view previous_rom, PatchFormat format) {
+        std::filesystem::path const rom_path{ExportedRomPath()};
+        std::string rom;
+        if (rom_path.empty() || !ReadFile(rom_path, rom))
+            return false;
+
+        auto const patch{CreatePatch(format, previous_rom, rom)};
+        if (!patch)
+            return false;
+
+        if (auto const patched{ApplyPatch(format, previous_rom, *patch)}; !patched || *patched != rom)
+            return false;
+
+        std::filesystem::path patch_path{rom_path};
+        patch_path.replace_extension(PatchExtension(format));
+        return WriteFile(patch_path, *patch);
+    }
+}
+
+#ifdef _WIN32
+#define MAKE ".\\bin\\make.exe"
+#define OUTPUT_FOLDER "..\\output"
+#define CA65 "..\\bin\\ca65.exe"
+#define LD65 "..\\bin\\ld65.exe"
+#define OS_OPTION "OS=Windows_NT"
+#else
+#define MAKE "./bin/make"
+#define OUTPUT_FOLDER "../output"
+#define CA65 "../bin/ca65"
+#define LD65 "../bin/ld65"
+#define OS_OPTION nullptr
+#endif
+
+constexpr std::string_view c_OutputDirectory{"output"};
+constexpr std::string_view c_RomExtension{".nes"};
+
+int EncodedRowCount(SlideGrid const &slide) noexcept {
+    int const last{slide.row_count - 1};
+    return slide.row_lengths[last] == 0 && !slide.IsBigText(last) ? last : slide.row_count;
+}
+
+int ScreenRowCount(SlideGrid const &slide) noexcept {
+    int const row_count{EncodedRowCount(slide)};
+
+    int screen_rows{0};
+    for (int row{0}; row < row_count; ++row)
+        screen_rows += slide.IsBigText(row) ? 2 : 1;
+
+    return screen_rows;
+}
+
+std::size_t EncodedSize(SlideGrid const &slide) {
+    int const row_count{EncodedRowCount(slide)};
+
+    // The slide terminator, then per row its glyphs, NEWLINE and BIG_TEXT if it is big.
+    std::size_t size{1};
+    for (int row{0}; row < row_count; ++row)
+        size += slide.row_lengths[row] + 1u + (slide.IsBigText(row) ? 1u : 0u);
+
+    return size;
+}
+
+ExportCache::Encoding ExportCache::Encode(SlideGrid const &slide) {
+    std::lock_guard lock{mutex_};
+    auto const [it, inserted]{entries_.try_emplace(HashBytes(slide.Bytes()))};
+    auto &entry{it->second};
+    if (inserted || entry.source != slide) {
+        entry.source = slide;
+        entry.encoded = std::make_shared<std::string const>(EncodeSlide(slide));
+    }
+
+    return entry.encoded;
+}
+
+ExportCache::Encoding ExportCache::Find(SlideGrid const &slide) const {
+    std::lock_guard lock{mutex_};
+    auto const it{entries_.find(HashBytes(slide.Bytes()))};
+    if (it == entries_.end() || it->second.source != slide)
+        return nullptr;
+
+    return it->second.encoded;
+}
+
+void ExportCache::Insert(SlideGrid const &slide, std::string encoded) {
+    std::lock_guard lock{mutex_};
+    entries_.insert_or_assign(HashBytes(slide.Bytes()), Entry{slide, std::make_shared<std::string const>(std::move(encoded))});
+}
+
+namespace {
+    // `for_each_slide` calls its argument with every slide in order.
+    template<typename ForEachSlide>
+    [[nodiscard]]
+    std::string AssembleSlides(std::size_t slide_count, ExportCache &cache, ForEachSlide for_each_slide) {
+        NESLIDES_TRACE("export", "assemble slides");
+        std::stringstream stream;
+        stream << ".rodata\nslides:\n";
+
+        std::size_t index{0};
+        for_each_slide([&](SlideGrid const &slide) {
+            stream << *cache.Encode(slide);
+
+            if (++index != slide_count) {
+                stream << ".byte NEXT_SLIDE\n";
+            } else {
+                stream << ".byte LAST_SLIDE\n";
+            }
+        });
+
+        return stream.str();
+    }
+
+    [[nodiscard]]
+    bool BuildRom(std::string const &source, PatchFormat patch_format) {
+        {
+            NESLIDES_TRACE("io", "write slides.s65");
+            std::ofstream file{"neslides/src/segments/slides.s65"};
+            if (!file.is_open())
+                return false;
+
+            file << source;
+
+            file.close();
+        }
+
+        // make clean removes the previous ROM, so it has to be read before building.
+        std::string previous_rom;
+        bool const has_previous_rom{patch_format != PatchFormat::None && ReadFile(ExportedRomPath(), previous_rom)};
+
+        std::array<char const *, 7> cleanCmd{MAKE, "clean", "-C", "neslides", "OUT_DIR=" OUTPUT_FOLDER, OS_OPTION, nullptr};
+        if (NESLIDES_TRACE("process", "make clean"); !start_process(cleanCmd))
+            return false;
+
+        // ca65 and ld65 run as children of make, their time is part of this span.
+        std::array<char const *, 9> buildCmd{MAKE, "all", "-C", "neslides", "CA65=" CA65, "LD65=" LD65, "OUT_DIR=" OUTPUT_FOLDER, OS_OPTION, nullptr};
+        if (NESLIDES_TRACE("process", "make all"); !start_process(buildCmd))
+            return false;
+
+        NESLIDES_TRACE("export", "patch");
+        return !has_previous_rom || WritePatch(previous_rom, patch_format);
+    }
+}
+
+bool Export(Slides const &input, ExportCache &cache, PatchFormat patch_format) {
+    NESLIDES_TRACE("export", "Export");
+    return BuildRom(AssembleSlides(input.size(), cache, [&](auto const &function) {
+        for (auto const &slide : input)
+            function(slide);
+    }), patch_format);
+}
+
+bool Export(DeckSnapshot const &input, ExportCache &cache, PatchFormat patch_format) {
+    NESLIDES_TRACE("export", "Export");
+    return BuildRom(AssembleSlides(input.size(), cache, [&](auto const &function) {
+        input.ForEach([&](std::size_t, SlideSnapshot const &slide) {
+            function(*slide.grid);
+        });
+    }), patch_format);
+}
+
+std::filesystem::path ExportedRomPath() {
+    std::error_code error;
+    for (auto const &entry : std::filesystem::directory_iterator{c_OutputDirectory, error}) {
+        if (entry.is_regular_file(error) && entry.path().extension() == c_RomExtension)
+            return entry.path();
+    }
+
+    return {};
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "slides.h"
+#include "slide_snapshot.h"
+#include "patch.h"
+
+// Encoded slide bodies keyed by the hash of their grid. One cache is shared by every deck in the editor, so
+// exporting a deck only encodes the slides that changed since any deck was last exported. It may be used from a
+// background export and an autosave at once. Encodings are handed out shared, so one replaced or cleared meanwhile
+// stays alive for whoever still reads it.
+class ExportCache final {
+public:
+    using Encoding = std::shared_ptr<std::string const>;
+
+    [[nodiscard]]
+    Encoding Encode(SlideGrid const &slide);
+
+    // The cached encoding of the slide, if any, without encoding it. Null if there is none.
+    [[nodiscard]]
+    Encoding Find(SlideGrid const &slide) const;
+
+    // Seeds the cache with an encoding produced earlier, e.g. restored from a session snapshot.
+    void Insert(SlideGrid const &slide, std::string encoded);
+
+    [[nodiscard]]
+    std::size_t Size() const {
+        std::lock_guard lock{mutex_};
+        return entries_.size();
+    }
+
+    void Clear() {
+        std::lock_guard lock{mutex_};
+        entries_.clear();
+    }
+
+private:
+    struct Entry final {
+        SlideGrid source;
+        Encoding encoded;
+    };
+
+    std::unordered_map<std::uint64_t, Entry> entries_;
+    mutable std::mutex mutex_;
+};
+
+// The rows the slide encodes. A trailing empty row is where the cursor goes next, not a line of the slide.
+[[nodiscard]]
+int EncodedRowCount(SlideGrid const &slide) noexcept;
+
+// The rows of the NES screen the slide takes, big text rows taking two. Whatever measures a slide against c_MaxRows
+// counts with this.
+[[nodiscard]]
+int ScreenRowCount(SlideGrid const &slide) noexcept;
+
+// The bytes the slide takes in the ROM, its terminator included.
+[[nodiscard]]
+std::size_t EncodedSize(SlideGrid const &slide);
+
+// With a patch format, the ROM already in the output folder is diffed against the new one and the patch, verified by
+// applying it in memory, is written next to the new ROM.
+[[nodiscard]]
+bool Export(Slides const &input, ExportCache &cache, PatchFormat patch_format = PatchFormat::None);
+
+// Exports a snapshot, so the export can run in the background while the deck is being edited.
+[[nodiscard]]
+bool Export(DeckSnapshot const &input, ExportCache &cache, PatchFormat patch_format = PatchFormat::None);
+
+// The ROM the last export left in the output folder, empty when there is none.
+[[nodiscard]]
+std::filesystem::path ExportedRomPath();
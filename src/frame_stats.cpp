@@ -0,0 +1,147 @@
+#include "frame_stats.h"
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ftxui/component/component.hpp>
+#include <ftxui/component/event.hpp>
+#include <ftxui/dom/elements.hpp>
+
+#include "deck_io.h"
+#include "trace.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    class InstrumentedComponent final : public ftxui::ComponentBase {
+    public:
+        InstrumentedComponent(ftxui::Component child, FrameStats &stats)
+            : stats_{stats} {
+            Add(std::move(child));
+        }
+
+        ftxui::Element Render() override {
+            using namespace ftxui;
+
+            auto const start{Clock::now()};
+            if (last_frame_)
+                stats_.frame_interval.Add(start - *last_frame_);
+            last_frame_ = start;
+
+            if (pending_event_) {
+                stats_.input_latency.Add(start - *pending_event_);
+                pending_event_.reset();
+            }
+
+            auto element{[&] {
+                NESLIDES_TRACE("ui", "render");
+                return ComponentBase::Render();
+            }()};
+            stats_.render.Add(Clock::now() - start);
+
+            if (!stats_.visible)
+                return element;
+
+            return dbox({
+                element,
+                vbox({filler(), hbox({filler(), Overlay()})})
+            });
+        }
+
+        bool OnEvent(ftxui::Event event) override {
+            using ftxui::Event;
+
+            auto const start{Clock::now()};
+            if (!pending_event_)
+                pending_event_ = start;
+
+            if (event == Event::F12) {
+                stats_.visible = !stats_.visible;
+                return true;
+            }
+
+            if (event == Event::F11 && stats_.visible) {
+                dumped_ = stats_.Dump(c_FrameStatsFileName);
+                return true;
+            }
+
+            NESLIDES_TRACE("ui", "event");
+            bool const handled{ComponentBase::OnEvent(event)};
+            stats_.event_handling.Add(Clock::now() - start);
+            return handled;
+        }
+
+    private:
+        FrameStats &stats_;
+        std::optional<Clock::time_point> last_frame_;
+        // The first event since the last frame.
+        std::optional<Clock::time_point> pending_event_;
+        std::optional<bool> dumped_;
+
+        [[nodiscard]]
+        ftxui::Element Overlay() const {
+            using namespace ftxui;
+
+            auto const row{[](std::string_view name, LatencySamples const &samples) {
+                auto const summary{samples.Summarize()};
+                return text(summary
+                    ? std::format("{:<9} p50 {:>8.0f} p99 {:>8.0f} max {:>8.0f} us", name, summary->p50, summary->p99, summary->max)
+                    : std::format("{:<9} no samples", name));
+            }};
+
+            Elements rows{
+                row("event", stats_.event_handling),
+                row("render", stats_.render),
+                row("latency", stats_.input_latency),
+                row("frame", stats_.frame_interval),
+                separator(),
+                text(dumped_ ? (*dumped_ ? std::format("Dumped to {}", c_FrameStatsFileName) : std::string{"Dump failed"}) : "F11 dumps the samples") | dim
+            };
+
+            return vbox(std::move(rows)) | border | clear_under;
+        }
+    };
+}
+
+void LatencySamples::Add(std::chrono::steady_clock::duration duration) noexcept {
+    samples_[next_] = std::chrono::duration<float, std::micro>(duration).count();
+    next_ = (next_ + 1) % c_Capacity;
+    size_ = std::min(size_ + 1, c_Capacity);
+}
+
+std::optional<LatencySamples::Summary> LatencySamples::Summarize() const {
+    if (size_ == 0)
+        return std::nullopt;
+
+    std::vector<float> sorted(samples_.begin(), samples_.begin() + static_cast<std::ptrdiff_t>(size_));
+    std::ranges::sort(sorted);
+
+    auto const percentile{[&](std::size_t percent) {
+        return sorted[std::min(sorted.size() - 1, sorted.size() * percent / 100)];
+    }};
+
+    return Summary{percentile(50), percentile(99), sorted.back()};
+}
+
+bool FrameStats::Dump(std::filesystem::path const &path) const {
+    std::string csv{"measurement,microseconds\n"};
+
+    auto const append{[&](std::string_view name, LatencySamples const &samples) {
+        for (std::size_t i{0}; i < samples.Size(); ++i)
+            csv += std::format("{},{:.1f}\n", name, samples[i]);
+    }};
+
+    append("event", event_handling);
+    append("render", render);
+    append("latency", input_latency);
+    append("frame", frame_interval);
+
+    return WriteFile(path, csv);
+}
+
+ftxui::Component Instrument(ftxui::Component child, FrameStats &stats) {
+    return ftxui::Make<InstrumentedComponent>(std::move(child), stats);
+}
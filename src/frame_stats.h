@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+#include <ftxui/component/component_base.hpp>
+
+constexpr std::string_view c_FrameStatsFileName{"frame_stats.csv"};
+
+// The last samples of one measurement, in microseconds. Older samples are overwritten.
+class LatencySamples final {
+public:
+    static constexpr std::size_t c_Capacity{1024};
+
+    struct Summary final {
+        float p50{};
+        float p99{};
+        float max{};
+    };
+
+    void Add(std::chrono::steady_clock::duration duration) noexcept;
+
+    [[nodiscard]]
+    std::size_t Size() const noexcept {
+        return size_;
+    }
+
+    // Oldest first.
+    [[nodiscard]]
+    float operator[](std::size_t index) const noexcept {
+        return samples_[(next_ + c_Capacity - size_ + index) % c_Capacity];
+    }
+
+    [[nodiscard]]
+    std::optional<Summary> Summarize() const;
+
+private:
+    std::array<float, c_Capacity> samples_{};
+    std::size_t next_{0};
+    std::size_t size_{0};
+};
+
+// How long the editor takes to handle events and build frames, and how long an event waits before the frame showing
+// its effect is built.
+struct FrameStats final {
+    LatencySamples event_handling;
+    LatencySamples render;
+    LatencySamples input_latency;
+    LatencySamples frame_interval;
+    bool visible{false};
+
+    // Writes every sample as `measurement,microseconds` lines.
+    [[nodiscard]]
+    bool Dump(std::filesystem::path const &path) const;
+};
+
+// Wraps the component so every event and frame going through it is timed. F12 toggles an overlay with p50, p99 and
+// max of each measurement, F11 dumps the samples to c_FrameStatsFileName.
+[[nodiscard]]
+ftxui::Component Instrument(ftxui::Component child, FrameStats &stats);
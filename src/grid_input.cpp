@@ -0,0 +1,280 @@
+#include "grid_input.h"
+
+#include <algorithm>
+
+#include <ftxui/component/mouse.hpp>
+#include <ftxui/dom/elements.hpp>
+
+#include "deck.h"
+
+namespace {
+    // Whether another row like `row` still leaves the slide within c_MaxSlideLines rows of the screen, big text rows
+    // taking two as ScreenRowCount counts them.
+    [[nodiscard]]
+    bool FitsAnotherRow(SlideGrid const &grid, int row) noexcept {
+        int screen_rows{grid.IsBigText(row) ? 2 : 1};
+        for (int i{0}; i < grid.row_count; ++i)
+            screen_rows += grid.IsBigText(i) ? 2 : 1;
+
+        return screen_rows <= c_MaxSlideLines;
+    }
+}
+
+GridInput::GridInput(Deck &deck, int const &slide, std::function<void(std::size_t)> on_change)
+    : deck_{deck}
+    , slide_{slide}
+    , on_change_{std::move(on_change)}
+    , bound_{deck.Id(static_cast<std::size_t>(slide))} {
+}
+
+GridCursor GridInput::Cursor(SlideId slide) const {
+    if (slide == bound_)
+        return cursor_;
+
+    auto const it{cursors_.find(slide)};
+    return it != cursors_.end() ? it->second : GridCursor{};
+}
+
+void GridInput::SetCursor(SlideId slide, GridCursor cursor) {
+    if (slide == bound_)
+        cursor_ = cursor;
+    else
+        cursors_.insert_or_assign(slide, cursor);
+}
+
+void GridInput::ForgetCursors() noexcept {
+    cursors_.clear();
+    bound_ = deck_.Id(static_cast<std::size_t>(slide_));
+    cursor_ = {};
+}
+
+SlideGrid &GridInput::Grid() noexcept {
+    return deck_.Storage().slides[static_cast<std::size_t>(slide_)];
+}
+
+void GridInput::Follow() {
+    SlideId const id{deck_.Id(static_cast<std::size_t>(slide_))};
+    if (id == bound_)
+        return;
+
+    cursors_.insert_or_assign(bound_, cursor_);
+    auto const it{cursors_.find(id)};
+    cursor_ = it != cursors_.end() ? it->second : GridCursor{};
+    if (it != cursors_.end())
+        cursors_.erase(it);
+    bound_ = id;
+}
+
+void GridInput::ToggleBigText() {
+    Follow();
+    ClampCursor();
+    Grid().SetBigText(cursor_.row, !Grid().IsBigText(cursor_.row));
+    Changed();
+}
+
+std::size_t GridInput::Paste(std::string_view text) {
+    Follow();
+    ClampCursor();
+    auto &grid{Grid()};
+    auto &[row, column]{cursor_};
+
+    // Unlike typing, a paste never runs into the row the NES screen keeps free, the rest goes on to new slides.
+    std::size_t consumed{0};
+    for (char const glyph : text) {
+        bool const wraps{IsSlideGlyph(glyph) && grid.row_lengths[row] == c_MaxColumns && column == c_MaxColumns};
+        if ((glyph == '\n' || wraps) && !FitsAnotherRow(grid, row))
+            break;
+
+        if (glyph == '\n') {
+            if (!grid.SplitRow(row, column))
+                break;
+            ++row;
+            column = 0;
+        } else if (IsSlideGlyph(glyph) && !Insert(glyph)) {
+            break;
+        }
+        ++consumed;
+    }
+
+    if (consumed > 0)
+        Changed();
+    return consumed;
+}
+
+void GridInput::Changed() {
+    if (on_change_)
+        on_change_(static_cast<std::size_t>(slide_));
+}
+
+void GridInput::ClampCursor() noexcept {
+    auto const &grid{Grid()};
+    cursor_.row = std::clamp(cursor_.row, 0, grid.row_count - 1);
+    cursor_.column = std::clamp(cursor_.column, 0, static_cast<int>(grid.row_lengths[cursor_.row]));
+}
+
+bool GridInput::Insert(char glyph) {
+    auto &grid{Grid()};
+    auto &[row, column]{cursor_};
+
+    if (glyph == c_BigTextMarker[1] && column > 0 && grid.glyphs[row][column - 1] == c_BigTextMarker[0]) {
+        (void)grid.EraseGlyph(row, --column);
+        grid.SetBigText(row, true);
+        return true;
+    }
+
+    // Typing past the end of a full row carries on on a new row.
+    bool split{false};
+    if (grid.row_lengths[row] == c_MaxColumns && column == c_MaxColumns) {
+        if (!grid.SplitRow(row, column))
+            return false;
+        ++row;
+        column = 0;
+        split = true;
+    }
+
+    if (!grid.InsertGlyph(row, column, glyph))
+        return split;
+
+    ++column;
+    return true;
+}
+
+ftxui::Element GridInput::Render() {
+    using namespace ftxui;
+
+    Follow();
+    ClampCursor();
+    auto const &grid{Grid()};
+    bool const focused{Focused()};
+
+    Elements rows;
+    rows.reserve(grid.row_count);
+    for (int row{0}; row < grid.row_count; ++row) {
+        std::string const glyphs{grid.Row(row)};
+        Element line;
+
+        if (row == cursor_.row && focused) {
+            auto const column{static_cast<std::size_t>(cursor_.column)};
+            bool const at_end{column == glyphs.size()};
+            line = hbox({
+                text(glyphs.substr(0, column)),
+                text(at_end ? " " : glyphs.substr(column, 1)) | inverted | focus,
+                text(at_end ? "" : glyphs.substr(column + 1))
+            });
+        } else {
+            line = text(glyphs);
+        }
+
+        rows.push_back(grid.IsBigText(row) ? line | bold : line);
+    }
+
+    return vbox(std::move(rows)) | frame | reflect(box_) | border;
+}
+
+bool GridInput::OnEvent(ftxui::Event event) {
+    using ftxui::Event;
+
+    Follow();
+    if (event.is_mouse())
+        return OnMouseEvent(event);
+
+    ClampCursor();
+    auto &grid{Grid()};
+    auto &[row, column]{cursor_};
+
+    // Moving past the edges of the slide is left to the enclosing container, so focus can leave the editor.
+    if (event == Event::ArrowLeft) {
+        if (column > 0) {
+            --column;
+        } else if (row > 0) {
+            --row;
+            column = grid.row_lengths[row];
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    if (event == Event::ArrowRight) {
+        if (column < grid.row_lengths[row]) {
+            ++column;
+        } else if (row + 1 < grid.row_count) {
+            ++row;
+            column = 0;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    if (event == Event::ArrowUp || event == Event::ArrowDown) {
+        int const next_row{row + (event == Event::ArrowUp ? -1 : 1)};
+        if (next_row < 0 || next_row >= grid.row_count)
+            return false;
+
+        row = next_row;
+        ClampCursor();
+        return true;
+    }
+
+    if (event == Event::Home || event == Event::End) {
+        column = event == Event::Home ? 0 : grid.row_lengths[row];
+        return true;
+    }
+
+    if (event == Event::Return) {
+        if (grid.SplitRow(row, column)) {
+            ++row;
+            column = 0;
+            Changed();
+        }
+        return true;
+    }
+
+    if (event == Event::Backspace) {
+        if (column > 0) {
+            (void)grid.EraseGlyph(row, --column);
+            Changed();
+        } else if (row > 0) {
+            int const joined_column{grid.row_lengths[row - 1]};
+            if (grid.JoinRows(row - 1)) {
+                --row;
+                column = joined_column;
+                Changed();
+            }
+        }
+        return true;
+    }
+
+    if (event == Event::Delete) {
+        if (column < grid.row_lengths[row] ? grid.EraseGlyph(row, column) : grid.JoinRows(row))
+            Changed();
+        return true;
+    }
+
+    if (event.is_character()) {
+        std::string const character{event.character()};
+        if (character.size() == 1 && IsSlideGlyph(character.front()) && Insert(character.front()))
+            Changed();
+        return true;
+    }
+
+    return false;
+}
+
+bool GridInput::OnMouseEvent(ftxui::Event event) {
+    using ftxui::Mouse;
+
+    auto const &mouse{event.mouse()};
+    if (!CaptureMouse(event) || !box_.Contain(mouse.x, mouse.y))
+        return false;
+
+    if (mouse.button != Mouse::Left || mouse.motion != Mouse::Pressed)
+        return false;
+
+    TakeFocus();
+    cursor_.row = mouse.y - box_.y_min;
+    cursor_.column = mouse.x - box_.x_min;
+    ClampCursor();
+    return true;
+}
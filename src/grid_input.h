@@ -0,0 +1,66 @@
+#pragma once
+
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+#include <ftxui/component/component_base.hpp>
+#include <ftxui/component/event.hpp>
+#include <ftxui/screen/box.hpp>
+
+#include "slides.h"
+
+class Deck;
+
+// Edits a slide of a deck in place, the FTXUI counterpart of an Input for SlideGrid. Typing `\b` marks the row as
+// big text, as it does in the text form. `on_change` is called with the slide index after every edit.
+//
+// One editor serves the whole deck: it follows the index it is given and keeps a cursor per slide id, so navigating,
+// deleting or undoing never needs a widget per slide.
+class GridInput final : public ftxui::ComponentBase {
+public:
+    GridInput(Deck &deck, int const &slide, std::function<void(std::size_t)> on_change = {});
+
+    // The cursor the slide had when it was last edited, the live one for the slide being edited.
+    [[nodiscard]]
+    GridCursor Cursor(SlideId slide) const;
+
+    void SetCursor(SlideId slide, GridCursor cursor);
+
+    // Drops the cursors of every slide, for when the whole deck was replaced.
+    void ForgetCursors() noexcept;
+
+    void ToggleBigText();
+
+    // Inserts the text at the cursor as a single edit, '\n' starting a new row, and stops where the slide is full, at
+    // c_MaxSlideLines rows of the screen. Returns how much of the text was used.
+    std::size_t Paste(std::string_view text);
+
+    ftxui::Element Render() override;
+    bool OnEvent(ftxui::Event event) override;
+
+    [[nodiscard]]
+    bool Focusable() const override {
+        return true;
+    }
+
+private:
+    Deck &deck_;
+    int const &slide_;
+    std::function<void(std::size_t)> on_change_;
+    // The slide the cursor belongs to. Cursors of the other slides are parked by id.
+    SlideId bound_{};
+    GridCursor cursor_;
+    std::unordered_map<SlideId, GridCursor> cursors_;
+    ftxui::Box box_;
+
+    [[nodiscard]]
+    SlideGrid &Grid() noexcept;
+
+    // Swaps the cursor when the slide at the followed index is not the one the cursor belongs to.
+    void Follow();
+    void ClampCursor() noexcept;
+    void Changed();
+    bool Insert(char glyph);
+    bool OnMouseEvent(ftxui::Event event);
+};
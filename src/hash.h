@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// FNV-1a, used wherever slide or deck content needs a cheap identity.
+[[nodiscard]]
+constexpr std::uint64_t HashBytes(std::string_view bytes, std::uint64_t hash = 0xcbf29ce484222325ull) noexcept {
+    for (char const c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
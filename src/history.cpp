@@ -0,0 +1,58 @@
+#include "history.h"
+
+#include <algorithm>
+
+History::History(std::size_t capacity)
+    : capacity_{std::max<std::size_t>(capacity, 2)} {
+    steps_.emplace_back();
+}
+
+void History::Reset(DeckSnapshot deck) {
+    steps_.clear();
+    steps_.push_back({std::move(deck), 0});
+    current_ = 0;
+    last_was_typing_ = false;
+}
+
+void History::Record(HistoryStep step, bool typing) {
+    auto const now{std::chrono::steady_clock::now()};
+    bool const coalesce{
+        typing && last_was_typing_ && current_ > 0 && current_ + 1 == steps_.size() &&
+        steps_[current_].slide == step.slide && now - last_typing_ < c_TypingCoalesceWindow
+    };
+
+    last_was_typing_ = typing;
+    last_typing_ = now;
+
+    if (coalesce) {
+        steps_[current_] = std::move(step);
+        return;
+    }
+
+    steps_.resize(current_ + 1);
+    steps_.push_back(std::move(step));
+
+    if (steps_.size() > capacity_)
+        steps_.erase(steps_.begin());
+
+    current_ = steps_.size() - 1;
+}
+
+std::optional<HistoryStep> History::Undo() {
+    if (!CanUndo())
+        return std::nullopt;
+
+    last_was_typing_ = false;
+    int const slide{steps_[current_].slide};
+    --current_;
+    return HistoryStep{steps_[current_].deck, slide};
+}
+
+std::optional<HistoryStep> History::Redo() {
+    if (!CanRedo())
+        return std::nullopt;
+
+    last_was_typing_ = false;
+    ++current_;
+    return steps_[current_];
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "slide_snapshot.h"
+
+constexpr std::size_t c_HistoryCapacity{1000};
+
+// Edits to the same slide closer together than this are undone as one step.
+constexpr std::chrono::milliseconds c_TypingCoalesceWindow{1000};
+
+struct HistoryStep final {
+    DeckSnapshot deck;
+    // The slide the change was made on, where the editor goes when it is undone or redone.
+    int slide{0};
+};
+
+// Undo and redo over deck snapshots. Successive snapshots share every slide that did not change, so a step costs the
+// slides it changed and a pointer per 64 slides, not a copy of the deck.
+class History final {
+public:
+    explicit History(std::size_t capacity = c_HistoryCapacity);
+
+    // Forgets every step, e.g. when another deck is opened.
+    void Reset(DeckSnapshot deck);
+
+    // Records the deck after a change. Typing on the same slide as the last typing step, within the coalesce window,
+    // replaces that step instead of adding one.
+    void Record(HistoryStep step, bool typing = false);
+
+    // The state to go back to, if any. Its slide is the one the undone change was made on.
+    [[nodiscard]]
+    std::optional<HistoryStep> Undo();
+
+    [[nodiscard]]
+    std::optional<HistoryStep> Redo();
+
+    [[nodiscard]]
+    bool CanUndo() const noexcept {
+        return current_ > 0;
+    }
+
+    [[nodiscard]]
+    bool CanRedo() const noexcept {
+        return current_ + 1 < steps_.size();
+    }
+
+private:
+    std::vector<HistoryStep> steps_;
+    std::size_t current_{0};
+    std::size_t capacity_;
+    bool last_was_typing_{false};
+    std::chrono::steady_clock::time_point last_typing_;
+};
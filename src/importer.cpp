@@ -0,0 +1,256 @@
+#include "importer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace {
+    [[nodiscard]]
+    std::string_view Trim(std::string_view text) {
+        auto const first{text.find_first_not_of(' ')};
+        if (first == std::string_view::npos)
+            return {};
+
+        auto const last{text.find_last_not_of(' ')};
+        return text.substr(first, last - first + 1);
+    }
+
+    [[nodiscard]]
+    bool IsThematicBreak(std::string_view line, ImportFormat format) {
+        if (format == ImportFormat::PlainText)
+            return line == "---";
+
+        if (line.empty() || (line.front() != '-' && line.front() != '*' && line.front() != '_'))
+            return false;
+
+        int count{0};
+        for (char const c : line) {
+            if (c == line.front())
+                ++count;
+            else if (c != ' ')
+                return false;
+        }
+
+        return count >= 3;
+    }
+
+    [[nodiscard]]
+    int HeadingLevel(std::string_view line) {
+        auto const level{std::min(line.find_first_not_of('#'), line.size())};
+        if (level == 0 || level > 6)
+            return 0;
+
+        if (level != line.size() && line[level] != ' ')
+            return 0;
+
+        return static_cast<int>(level);
+    }
+
+    [[nodiscard]]
+    bool IsCodeFence(std::string_view line) {
+        return line.starts_with("```") || line.starts_with("~~~");
+    }
+
+    // Strips the inline Markdown the NES font has no use for and reports whether the line was emphasized.
+    void StripInline(std::string_view line, std::string &out, bool &emphasized) {
+        out.clear();
+        emphasized = false;
+
+        if (line.starts_with("> "))
+            line.remove_prefix(2);
+
+        for (std::size_t i{0}; i < line.size(); ++i) {
+            char const c{line[i]};
+            std::string_view const rest{line.substr(i)};
+
+            if (rest.starts_with("**") || rest.starts_with("__")) {
+                emphasized = true;
+                ++i;
+                continue;
+            }
+
+            if (c == '`')
+                continue;
+
+            if (rest.starts_with("![") || c == '[') {
+                auto const label_start{c == '!' ? i + 2 : i + 1};
+                auto const label_end{line.find("](", label_start)};
+                auto const url_end{label_end == std::string_view::npos ? label_end : line.find(')', label_end)};
+                if (url_end != std::string_view::npos) {
+                    out.append(line.substr(label_start, label_end - label_start));
+                    i = url_end;
+                    continue;
+                }
+            }
+
+            out.push_back(c);
+        }
+    }
+
+    class SlideBuilder final {
+    public:
+        void BreakSlide() {
+            pending_blank_ = false;
+            if (lines_ == 0)
+                return;
+
+            current_.row_count = static_cast<std::uint8_t>(lines_);
+            slides_.push_back(current_);
+            current_ = SlideGrid{};
+            lines_ = 0;
+            screen_rows_ = 0;
+        }
+
+        void AddBlank() {
+            pending_blank_ = lines_ != 0;
+        }
+
+        // Word-wraps the text to c_MaxColumns, words that do not fit on a row on their own are hard-split.
+        void AddParagraph(std::string_view text, bool big) {
+            if (text.find(c_BigTextMarker) != std::string_view::npos) {
+                big = true;
+                scratch_.clear();
+                for (auto pos{text.find(c_BigTextMarker)}; pos != std::string_view::npos; pos = text.find(c_BigTextMarker)) {
+                    scratch_.append(text.substr(0, pos));
+                    text.remove_prefix(pos + c_BigTextMarker.size());
+                }
+                scratch_.append(text);
+                text = scratch_;
+            }
+
+            text = Trim(text);
+            row_.clear();
+            while (!text.empty()) {
+                auto const word_end{std::min(text.find(' '), text.size())};
+                std::string_view word{text.substr(0, word_end)};
+                text = Trim(text.substr(word_end));
+
+                if (!row_.empty() && row_.size() + 1 + word.size() > c_MaxColumns) {
+                    AddRow(row_, big);
+                    row_.clear();
+                }
+
+                while (word.size() > c_MaxColumns) {
+                    if (!row_.empty()) {
+                        AddRow(row_, big);
+                        row_.clear();
+                    }
+                    AddRow(word.substr(0, c_MaxColumns), big);
+                    word.remove_prefix(c_MaxColumns);
+                }
+
+                if (!row_.empty())
+                    row_.push_back(' ');
+                row_.append(word);
+            }
+
+            if (!row_.empty())
+                AddRow(row_, big);
+        }
+
+        [[nodiscard]]
+        Slides Finish() {
+            BreakSlide();
+            if (slides_.empty())
+                slides_.emplace_back();
+
+            return std::move(slides_);
+        }
+
+    private:
+        Slides slides_;
+        SlideGrid current_;
+        std::string row_;
+        std::string scratch_;
+        int lines_{0};
+        // Rows of the screen the slide takes so far, big rows taking two as ScreenRowCount counts them.
+        int screen_rows_{0};
+        bool pending_blank_{false};
+
+        void AddRow(std::string_view row, bool big) {
+            int const row_screen_rows{big ? 2 : 1};
+
+            if (pending_blank_) {
+                pending_blank_ = false;
+                if (screen_rows_ + 1 + row_screen_rows > c_MaxSlideLines)
+                    BreakSlide();
+                else
+                    AddRow({}, false);
+            }
+
+            if (screen_rows_ + row_screen_rows > c_MaxSlideLines)
+                BreakSlide();
+
+            std::ranges::copy(row, current_.glyphs[lines_].begin());
+            current_.row_lengths[lines_] = static_cast<std::uint8_t>(row.size());
+            current_.SetBigText(lines_, big);
+            ++lines_;
+            screen_rows_ += row_screen_rows;
+        }
+    };
+}
+
+ImportFormat ImportFormatFromPath(std::string_view path) {
+    auto const extension_start{path.find_last_of('.')};
+    if (extension_start == std::string_view::npos)
+        return ImportFormat::PlainText;
+
+    std::string extension{path.substr(extension_start + 1)};
+    std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    return extension == "md" || extension == "markdown" ? ImportFormat::Markdown : ImportFormat::PlainText;
+}
+
+Slides ImportSlides(std::istream &input, ImportFormat format) {
+    SlideBuilder builder;
+    std::string line;
+    std::string stripped;
+    bool in_code_block{false};
+
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        std::ranges::replace(line, '\t', ' ');
+        std::erase_if(line, [](char glyph) { return !IsSlideGlyph(glyph); });
+
+        std::string_view const trimmed{Trim(line)};
+
+        if (format == ImportFormat::Markdown && IsCodeFence(trimmed)) {
+            in_code_block = !in_code_block;
+            continue;
+        }
+
+        if (trimmed.empty()) {
+            builder.AddBlank();
+            continue;
+        }
+
+        if (in_code_block) {
+            builder.AddParagraph(line, false);
+            continue;
+        }
+
+        if (IsThematicBreak(trimmed, format)) {
+            builder.BreakSlide();
+            continue;
+        }
+
+        if (format == ImportFormat::PlainText) {
+            builder.AddParagraph(trimmed, false);
+            continue;
+        }
+
+        bool emphasized;
+        if (int const level{HeadingLevel(trimmed)}; level != 0) {
+            builder.BreakSlide();
+            StripInline(Trim(trimmed.substr(level)), stripped, emphasized);
+            builder.AddParagraph(stripped, true);
+            continue;
+        }
+
+        StripInline(trimmed, stripped, emphasized);
+        builder.AddParagraph(stripped, emphasized);
+    }
+
+    return builder.Finish();
+}
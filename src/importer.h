@@ -0,0 +1,21 @@
+#pragma once
+
+#include <istream>
+#include <string_view>
+
+#include "slides.h"
+
+enum class ImportFormat {
+    Markdown,
+    PlainText
+};
+
+[[nodiscard]]
+ImportFormat ImportFormatFromPath(std::string_view path);
+
+// Reads the source in a single pass. Slides are split on `---` and, for Markdown, on headings.
+// Headings and emphasized lines become big text, long lines are wrapped to c_MaxColumns and
+// slides spill over onto a new one once they reach c_MaxSlideLines rows of the screen, big text taking two.
+// Characters a slide cannot hold are dropped, see IsSlideGlyph.
+[[nodiscard]]
+Slides ImportSlides(std::istream &input, ImportFormat format);
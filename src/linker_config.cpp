@@ -0,0 +1,145 @@
+#include "linker_config.h"
+
+#include <cctype>
+#include <charconv>
+#include <string>
+#include <unordered_map>
+
+#include "deck_io.h"
+
+namespace {
+    constexpr std::string_view c_LinkerConfigExtension{".cfg"};
+    constexpr std::string_view c_Punctuation{"{}:;=,"};
+
+    // Splits a config into words, numbers, strings and punctuation, dropping `#` comments.
+    class Tokenizer final {
+    public:
+        explicit Tokenizer(std::string_view config)
+            : config_{config} {
+        }
+
+        [[nodiscard]]
+        std::string_view Next() {
+            while (!config_.empty()) {
+                if (std::isspace(static_cast<unsigned char>(config_.front()))) {
+                    config_.remove_prefix(1);
+                } else if (config_.front() == '#') {
+                    auto const end{config_.find('\n')};
+                    config_.remove_prefix(end == std::string_view::npos ? config_.size() : end);
+                } else {
+                    break;
+                }
+            }
+
+            if (config_.empty())
+                return {};
+
+            std::size_t length{1};
+            if (config_.front() == '"') {
+                length = std::min(config_.find('"', 1), config_.size() - 1) + 1;
+            } else if (c_Punctuation.find(config_.front()) == std::string_view::npos) {
+                while (length < config_.size() && !std::isspace(static_cast<unsigned char>(config_[length])) &&
+                       c_Punctuation.find(config_[length]) == std::string_view::npos && config_[length] != '#')
+                    ++length;
+            }
+
+            auto const token{config_.substr(0, length)};
+            config_.remove_prefix(length);
+            return token;
+        }
+
+    private:
+        std::string_view config_;
+    };
+
+    [[nodiscard]]
+    std::optional<std::size_t> ParseNumber(std::string_view token) {
+        int base{10};
+        if (token.starts_with('$')) {
+            base = 16;
+            token.remove_prefix(1);
+        } else if (token.starts_with('%')) {
+            base = 2;
+            token.remove_prefix(1);
+        } else if (token.starts_with("0x") || token.starts_with("0X")) {
+            base = 16;
+            token.remove_prefix(2);
+        }
+
+        std::size_t value{};
+        auto const [end, error]{std::from_chars(token.data(), token.data() + token.size(), value, base)};
+        if (error != std::errc{} || end != token.data() + token.size())
+            return std::nullopt;
+
+        return value;
+    }
+
+    // Attribute values by area or segment name, by section name, e.g. sections["MEMORY"]["PRG"]["size"].
+    using Attributes = std::unordered_map<std::string_view, std::string_view>;
+    using Sections = std::unordered_map<std::string_view, std::unordered_map<std::string_view, Attributes>>;
+
+    [[nodiscard]]
+    std::optional<Sections> ParseConfig(std::string_view config) {
+        Tokenizer tokens{config};
+        Sections sections;
+
+        for (auto section{tokens.Next()}; !section.empty(); section = tokens.Next()) {
+            if (tokens.Next() != "{")
+                return std::nullopt;
+
+            auto &entries{sections[section]};
+            for (auto name{tokens.Next()}; name != "}"; name = tokens.Next()) {
+                if (name.empty() || tokens.Next() != ":")
+                    return std::nullopt;
+
+                auto &attributes{entries[name]};
+                for (auto attribute{tokens.Next()}; attribute != ";"; attribute = tokens.Next()) {
+                    if (attribute == ",")
+                        continue;
+
+                    if (attribute.empty() || tokens.Next() != "=")
+                        return std::nullopt;
+
+                    attributes[attribute] = tokens.Next();
+                }
+            }
+        }
+
+        return sections;
+    }
+}
+
+std::optional<std::size_t> SegmentCapacity(std::string_view config, std::string_view segment) {
+    auto const sections{ParseConfig(config)};
+    if (!sections || !sections->contains("MEMORY") || !sections->contains("SEGMENTS"))
+        return std::nullopt;
+
+    auto const &segments{sections->at("SEGMENTS")};
+    auto const segment_it{segments.find(segment)};
+    if (segment_it == segments.end() || !segment_it->second.contains("load"))
+        return std::nullopt;
+
+    auto const &areas{sections->at("MEMORY")};
+    auto const area_it{areas.find(segment_it->second.at("load"))};
+    if (area_it == areas.end() || !area_it->second.contains("size"))
+        return std::nullopt;
+
+    return ParseNumber(area_it->second.at("size"));
+}
+
+std::size_t LoadSlideCapacity(std::filesystem::path const &engine_directory) {
+    std::error_code error;
+    for (auto const &entry : std::filesystem::recursive_directory_iterator{engine_directory, error}) {
+        if (!entry.is_regular_file(error) || entry.path().extension() != c_LinkerConfigExtension)
+            continue;
+
+        std::string config;
+        if (!ReadFile(entry.path(), config))
+            continue;
+
+        if (auto const capacity{SegmentCapacity(config, c_SlideSegment)})
+            return *capacity;
+    }
+
+    return c_DefaultSlideCapacity;
+}
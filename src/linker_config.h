@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+// Export writes the slides to `.rodata`.
+constexpr std::string_view c_SlideSegment{"RODATA"};
+
+// The PRG ROM of an NROM-256 cartridge, assumed when the engine's linker config cannot be read.
+constexpr std::size_t c_DefaultSlideCapacity{0x8000};
+
+// The size of the memory area the segment is loaded into, per an ld65 linker config. Only plain number sizes are
+// understood, not expressions.
+[[nodiscard]]
+std::optional<std::size_t> SegmentCapacity(std::string_view config, std::string_view segment);
+
+// The room the slides have in the ROM, read from the first linker config in the engine directory that places the
+// slide segment. The engine's own code and data share that area, so this is an upper bound.
+[[nodiscard]]
+std::size_t LoadSlideCapacity(std::filesystem::path const &engine_directory = "neslides");
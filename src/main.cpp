@@ -1,95 +1,41 @@
 #include <iostream>
-#include <span>
+#include <algorithm>
 #include <array>
+#include <filesystem>
 #include <fstream>
 #include <format>
+#include <future>
+#include <optional>
 
 #include "tinyfiledialogs.h"
-#include "subprocess.h"
+#include "slides.h"
+#include "importer.h"
+#include "export.h"
+#include "deck_io.h"
+#include "thread_pool.h"
+#include "workspace.h"
+#include "converter.h"
+#include "rom_check.h"
+#include "session.h"
+#include "grid_input.h"
+#include "deck.h"
+#include "history.h"
+#include "slide_navigator.h"
+#include "linker_config.h"
+#include "paste.h"
+#include "render_cache.h"
+#include "slide_preview.h"
+#include "slide_overview.h"
+#include "thumbnail_cache.h"
+#include "search_panel.h"
+#include "replace_panel.h"
+#include "emulator_view.h"
+#include "frame_stats.h"
+#include "trace.h"
 #include <ftxui/dom/elements.hpp>
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/screen_interactive.hpp>
 
-[[nodiscard]]
-bool start_process(std::span<char const *> command) {
-    subprocess_s subprocess{};
-    if (int const result{subprocess_create(command.data(), subprocess_option_inherit_environment, &subprocess)}; result != 0) {
-        return false;
-    }
-
-    int process_return{};
-    if (const int result{subprocess_join(&subprocess, &process_return)}; result != 0) {
-        return false;
-    }
-
-    return true;
-}
-
-#ifdef _WIN32
-#define MAKE ".\\bin\\make.exe"
-#define OUTPUT_FOLDER "..\\output"
-#define CA65 "..\\bin\\ca65.exe"
-#define LD65 "..\\bin\\ld65.exe"
-#define OS_OPTION "OS=Windows_NT"
-#else
-#define MAKE "./bin/make"
-#define OUTPUT_FOLDER "../output"
-#define CA65 "../bin/ca65"
-#define LD65 "../bin/ld65"
-#define OS_OPTION nullptr
-#endif
-
-using Slides = std::vector<std::unique_ptr<std::string>>;
-
-[[nodiscard]]
-bool Export(Slides const &input) {
-    std::stringstream stream;
-    stream << ".rodata\nslides:\n";
-
-    for (auto it{input.begin()}; it != input.end(); ++it) {
-        std::string line;
-        std::stringstream input_stream{**it};
-        while (std::getline(input_stream, line, '\n')) {
-            stream << ".byte ";
-            bool contains_backslash_b{line.find("\\b") != std::string::npos};
-
-            stream << (contains_backslash_b ? "BIG_TEXT, " : "");
-            for (auto it = line.begin(); it != line.end(); ++it) {
-                char c = *it;
-                if (c == '\\' && it + 1 != line.end() && *(it + 1) == 'b') {
-                    ++it;
-                    continue;
-                }
-
-                stream << toupper(c) << ", ";
-            }
-
-            stream << "NEWLINE\n";
-        }
-
-        if (it + 1 != input.end()) {
-            stream << ".byte NEXT_SLIDE\n";
-        } else {
-            stream << ".byte LAST_SLIDE\n";
-        }
-    }
-
-    std::ofstream file{"neslides/src/segments/slides.s65"};
-    if (!file.is_open())
-        return false;
-
-    file << stream.str();
-
-    file.close();
-
-    std::array<char const *, 7> cleanCmd{MAKE, "clean", "-C", "neslides", "OUT_DIR=" OUTPUT_FOLDER, OS_OPTION, nullptr};
-    if (!start_process(cleanCmd))
-        return false;
-
-    std::array<char const *, 9> buildCmd{MAKE, "all", "-C", "neslides", "CA65=" CA65, "LD65=" LD65, "OUT_DIR=" OUTPUT_FOLDER, OS_OPTION, nullptr};
-    return start_process(buildCmd);
-}
-
 [[nodiscard]]
 ftxui::Component SuccessModal(std::function<void()> const &okay_clicked) {
     using namespace ftxui;
@@ -132,59 +78,125 @@ ftxui::Component ErrorModal(std::function<void()> const &okay_clicked) {
     return component;
 }
 
-constexpr std::array c_ExportExtensions{"*.neslides"};
+constexpr int c_CapacityMeterWidth{20};
 
-void SaveSlides(Slides const &slides) {
-    char const *const file_path{tinyfd_saveFileDialog("Save Slides", "", c_ExportExtensions.size(), c_ExportExtensions.data(), nullptr)};
-    if (!file_path)
-        return;
+// How much of the ROM the slides use, turning yellow past 90% and red once they no longer fit.
+[[nodiscard]]
+ftxui::Element CapacityMeter(std::size_t used, std::size_t capacity) {
+    using namespace ftxui;
 
-    std::ofstream file{file_path, std::ios::binary};
+    float const ratio{static_cast<float>(used) / static_cast<float>(std::max<std::size_t>(capacity, 1))};
+    Color const meter_color{ratio > 1.0f ? Color::Red : ratio > 0.9f ? Color::Yellow : Color::Green};
 
-    if (!file.is_open())
-        return;
+    return hbox({
+        gauge(std::min(ratio, 1.0f)) | size(WIDTH, EQUAL, c_CapacityMeterWidth),
+        text(std::format(" {} / {} B", used, capacity))
+    }) | color(meter_color);
+}
 
-    for (auto const &slide : slides) {
-        file.write(slide->c_str(), slide->size());
-        file.put('\0');
-    }
+// What the button row looks like: which control has focus, the patch format, and where the mouse hovers over it.
+struct HeaderKey final {
+    std::uint32_t focused{};
+    int patch_format{};
+    int mouse_x{-1};
+    int mouse_y{-1};
+
+    bool operator==(HeaderKey const &) const = default;
+};
+
+struct FooterKey final {
+    SlideMetrics slide;
+    DeckTotals totals;
+    std::size_t slide_count{};
+    bool exporting{};
+
+    bool operator==(FooterKey const &) const = default;
+};
+
+constexpr std::array c_ExportExtensions{"*.neslides"};
+
+// The path written to, if the slides were saved.
+[[nodiscard]]
+std::optional<std::filesystem::path> SaveSlides(DeckStorage &deck) {
+    char const *const file_path{tinyfd_saveFileDialog("Save Slides", "", c_ExportExtensions.size(), c_ExportExtensions.data(), nullptr)};
+    if (!file_path || !WriteSlidesFile(file_path, deck.slides))
+        return std::nullopt;
+
+    deck.arena.Compact(deck.slides);
+    return file_path;
 }
 
-void LoadSlides(Slides &out) {
+[[nodiscard]]
+bool LoadSlides(DeckStorage &out) {
     char const *const file_path{tinyfd_openFileDialog("Open Slides", "", c_ExportExtensions.size(), c_ExportExtensions.data(), nullptr, 0)};
     if (!file_path)
-        return;
+        return false;
 
-    std::ifstream file{file_path, std::ios::binary};
+    std::string bytes;
+    if (!ReadFile(file_path, bytes))
+        return false;
 
-    if (!file.is_open())
-        return;
-
-    out.clear();
-    std::string slide;
-    char c;
-    while (file.get(c)) {
-        if (c == '\0') {
-            out.emplace_back(std::make_unique<std::string>(slide));
-            slide.clear();
-        } else {
-            slide.push_back(c);
-        }
+    out.arena.Reset(out.slides, std::max<std::size_t>(CountSlides(bytes), 1));
+    if (auto const damaged{ParseSlides(bytes, out.slides)}; damaged > 0) {
+        auto const message{std::format("{} slides lost text that did not fit or that a slide cannot hold.", damaged)};
+        tinyfd_notifyPopup("Slides changed", message.c_str(), "warning");
     }
+
+    if (out.slides.empty())
+        out.slides.emplace_back();
+
+    return true;
 }
 
 [[nodiscard]]
-bool AskIfSure() {
-    return tinyfd_messageBox("Are you sure?", "Are you certain you want to perform this action?", "yesno", "question", 0) == 1;
+bool OpenWorkspace(Workspace &workspace, ThreadPool &pool) {
+    char const *const directory{tinyfd_selectFolderDialog("Open Workspace", "")};
+    if (!directory)
+        return false;
+
+    return workspace.Open(directory, pool);
 }
 
-constexpr int c_MaxColumns{26};
-constexpr int c_MaxRows{27};
+constexpr std::array c_ImportExtensions{"*.md", "*.markdown", "*.txt"};
+
+[[nodiscard]]
+bool ImportSlidesFromFile(DeckStorage &out) {
+    char const *const file_path{tinyfd_openFileDialog("Import Slides", "", c_ImportExtensions.size(), c_ImportExtensions.data(), "Markdown or plain text", 0)};
+    if (!file_path)
+        return false;
+
+    std::ifstream file{file_path, std::ios::binary};
+
+    if (!file.is_open())
+        return false;
+
+    Slides const imported{ImportSlides(file, ImportFormatFromPath(file_path))};
+    if (imported.empty())
+        return false;
 
-int main() {
+    out.arena.Reset(out.slides, imported.size());
+    out.slides.assign(imported.begin(), imported.end());
+    return true;
+}
+
+int main(int argc, char *argv[]) {
     using namespace ftxui;
 
+    if (argc > 1 && std::string_view{argv[1]} == "--convert")
+        return RunConverter({argv + 2, static_cast<std::size_t>(argc - 2)});
+
+    if (argc > 1 && std::string_view{argv[1]} == "--rom-check")
+        return RunRomCheck({argv + 2, static_cast<std::size_t>(argc - 2)});
+
+    if (argc > 1 && std::string_view{argv[1]} == "--paste-bench")
+        return RunPasteBenchmark();
+
+    FrameStats frame_stats;
+    frame_stats.visible = argc > 1 && std::string_view{argv[1]} == "--stats";
+
     auto screen{ScreenInteractive::Fullscreen()};
+    // FTXUI suspends the program on Ctrl+Z, even when a component handles it. Here it is undo.
+    screen.ForceHandleCtrlZ(false);
 
     bool success_shown = false;
     auto const show_success{[&]{ success_shown = true; }};
@@ -194,127 +206,458 @@ int main() {
     auto const show_error{[&]{ error_shown = true; }};
     auto const hide_error{[&]{ error_shown = false; }};
 
-    Slides slides;
-    slides.emplace_back(std::make_unique<std::string>(""));
+    ThreadPool pool;
+    ExportCache export_cache;
+    std::size_t const slide_capacity{LoadSlideCapacity()};
+
+    Deck deck;
 
-    std::vector<std::string> slide_titles{"Slide 0"};
+    Workspace workspace;
+    std::vector<std::string> deck_titles;
+    int current_deck_index{0};
+    int shown_deck_index{0};
 
-    std::vector slide_inputs{Input(slides.back().get()) | border};
+    History history;
+    history.Reset(deck.Snapshot());
 
     int current_slide_index{0};
-    auto tabs{Container::Tab({
-        slide_inputs.back()
-    }, &current_slide_index)};
+
+    std::future<bool> autosave;
+    auto last_autosave{std::chrono::steady_clock::now()};
+
+    std::shared_ptr<GridInput> editor;
+
+    auto const editor_state{[&] {
+        EditorState state;
+        state.current_slide = current_slide_index;
+        state.cursor_positions.reserve(deck.Size());
+        for (std::size_t i{0}; i < deck.Size(); ++i)
+            state.cursor_positions.push_back(editor->Cursor(deck.Id(i)));
+        return state;
+    }};
+
+    auto const record{[&](int slide, bool typing = false) {
+        history.Record({deck.Snapshot(), slide}, typing);
+
+        auto const now{std::chrono::steady_clock::now()};
+        if (now - last_autosave < c_AutosaveInterval || (autosave.valid() && autosave.wait_for(std::chrono::seconds{0}) != std::future_status::ready))
+            return;
+
+        last_autosave = now;
+        autosave = pool.Submit([&export_cache, snapshot = deck.Snapshot(), state = editor_state()] {
+            return SaveSession(c_SessionFileName, snapshot, state, export_cache);
+        });
+    }};
+
+    // Set while an edit made of several changes is applied, which records itself once it is done.
+    bool batching{false};
+
+    auto const slide_edited{[&](std::size_t slide) {
+        deck.Edited(slide);
+        if (!batching)
+            record(static_cast<int>(slide), true);
+    }};
+
+    editor = Make<GridInput>(deck, current_slide_index, slide_edited);
 
     auto const add_slide{[&] {
-        slides.emplace_back(std::make_unique<std::string>(""));
-        slide_inputs.emplace_back(Input(slides.back().get()) | border);
-        tabs->Add(slide_inputs.back());
-        slide_titles.emplace_back(std::format("Slide {}", slides.size() - 1));
-        current_slide_index = static_cast<int>(slides.size()) - 1;
+        current_slide_index = static_cast<int>(deck.Insert(deck.Size()));
+        record(current_slide_index);
     }};
 
+    std::vector<std::string> const patch_formats{"No patch", "IPS", "BPS"};
+    int patch_format_index{0};
+    auto const patch_toggle = Toggle(&patch_formats, &patch_format_index);
+
+    // Exports run on the pool from a snapshot, editing carries on meanwhile.
+    std::future<void> export_task;
+    bool exporting{false};
     auto const export_button = Button("Export", [&] {
-        if (Export(slides)) {
-            tinyfd_notifyPopup("Success", "Slides exported successfuly. You will find the ROM in the output folder.", "info");
-        }
-        else
+        if (exporting)
+            return;
+
+        exporting = true;
+        export_task = pool.Submit([&, snapshot = deck.Snapshot(), patch_format = static_cast<PatchFormat>(patch_format_index)] {
+            bool const exported{Export(snapshot, export_cache, patch_format)};
+            screen.Post([&, exported] {
+                exporting = false;
+                if (exported) {
+                    tinyfd_notifyPopup("Success", "Slides exported successfuly. You will find the ROM in the output folder.", "info");
+                }
+                else
+                    show_error();
+            });
+        });
+    }, ButtonOption::Ascii());
+
+    // Boots the last exported ROM in the built-in emulator.
+    bool emulator_shown{false};
+    auto const emulator{Make<EmulatorView>([&] { emulator_shown = false; })};
+    auto const run_rom = Button("Run ROM", [&] {
+        std::string rom;
+        if (exporting || !ReadFile(ExportedRomPath(), rom) || !emulator->Boot(rom)) {
             show_error();
+            return;
+        }
+        emulator_shown = true;
     }, ButtonOption::Ascii());
 
     auto const new_slide = Button("New Slide", add_slide, ButtonOption::Ascii());
     auto const delete_slide = Button("Delete Slide", [&] {
-        if (slides.size() > 1) {
-            if (!AskIfSure())
-                return;
-
-            slides.erase(slides.begin() + current_slide_index);
-            slide_inputs.erase(slide_inputs.begin() + current_slide_index);
-            slide_titles.erase(slide_titles.begin() + current_slide_index);
-            tabs->ChildAt(current_slide_index)->Detach();
-
-            for (auto title_it{slide_titles.begin() + current_slide_index}; title_it != slide_titles.end(); ++title_it) {
-                *title_it = std::format("Slide {}", std::distance(slide_titles.begin(), title_it));
-            }
-            current_slide_index = static_cast<int>(slides.size()) - 1;
+        if (deck.Size() > 1) {
+            int const deleted{current_slide_index};
+            deck.Erase(static_cast<std::size_t>(deleted));
+            current_slide_index = std::min(deleted, static_cast<int>(deck.Size()) - 1);
+            record(deleted);
         }
     }, ButtonOption::Ascii());
     auto const big_text = Button("Big Text", [&] {
-        *slides.back() += "\\b";
+        editor->ToggleBigText();
     }, ButtonOption::Ascii());
+    SlidePreview preview;
+    bool show_preview{true};
+    auto const preview_toggle = Button("Preview", [&] { show_preview = !show_preview; }, ButtonOption::Ascii());
     auto const reset = Button("Reset", [&] {
-        if (!AskIfSure())
+        deck.Clear();
+        current_slide_index = 0;
+        record(0);
+    }, ButtonOption::Ascii());
+
+    // After a loader replaced the whole deck. Opening another deck starts a new history, importing into this one can
+    // be undone.
+    auto const replace_deck{[&](bool undoable) {
+        deck.Replaced();
+        current_slide_index = 0;
+        editor->ForgetCursors();
+        if (undoable)
+            record(0);
+        else
+            history.Reset(deck.Snapshot());
+    }};
+
+    auto const restore{[&](std::optional<HistoryStep> const &step) {
+        if (!step)
             return;
 
-        slides.clear();
-        slide_inputs.clear();
-        slide_titles.clear();
-        tabs->DetachAllChildren();
-        add_slide();
-    }, ButtonOption::Ascii());
+        deck.Restore(step->deck);
+        current_slide_index = std::clamp(step->slide, 0, static_cast<int>(deck.Size()) - 1);
+    }};
 
-    auto const open = Button("Open", [&] {
-        LoadSlides(slides);
-
-        slide_inputs.clear();
-        slide_titles.clear();
-        tabs->DetachAllChildren();
-        for (auto const &slide : slides) {
-            slide_inputs.emplace_back(Input(slide.get()) | border);
-            tabs->Add(slide_inputs.back());
-            slide_titles.emplace_back(std::format("Slide {}", slide_titles.size()));
+    auto const undo = Button("Undo", [&] { restore(history.Undo()); }, ButtonOption::Ascii());
+    auto const redo = Button("Redo", [&] { restore(history.Redo()); }, ButtonOption::Ascii());
+
+    auto const deck_title{[&](DeckInfo const &deck) {
+        auto title{std::format("{} ({} slides, {} B", deck.path.stem().string(), deck.slide_count, deck.byte_size)};
+        if (deck.damaged_slides > 0)
+            title += std::format(", {} lost text", deck.damaged_slides);
+        return title + ")";
+    }};
+
+    // Asks what to do with decks of the open folder that have edits before they are dropped. False keeps the folder.
+    auto const release_workspace{[&] {
+        auto const shown{static_cast<std::size_t>(shown_deck_index)};
+        auto const edited{workspace.EditedDecks(shown, deck.Storage().slides)};
+        if (edited.empty())
+            return true;
+
+        auto const message{std::format("{} decks of the folder have unsaved edits. Save them?", edited.size())};
+        switch (tinyfd_messageBox("Unsaved Decks", message.c_str(), "yesnocancel", "question", 1)) {
+            case 1:
+                if (workspace.SaveEdited(shown, deck.Storage().slides)) {
+                    for (auto const i : edited)
+                        deck_titles[i] = deck_title(workspace.Decks()[i]);
+                    return true;
+                }
+                show_error();
+                return false;
+            case 2:
+                return true;
+            default:
+                return false;
         }
-        current_slide_index = 0;
+    }};
+
+    auto const open = Button("Open", [&] {
+        if (!release_workspace() || !LoadSlides(deck.Storage()))
+            return;
+
+        workspace.Close();
+        deck_titles.clear();
+        replace_deck(false);
+    }, ButtonOption::Ascii());
+
+    auto const open_folder = Button("Open Folder", [&] {
+        Workspace opened;
+        if (!release_workspace() || !OpenWorkspace(opened, pool))
+            return;
+
+        workspace = std::move(opened);
+
+        deck_titles.clear();
+        for (auto const &deck : workspace.Decks())
+            deck_titles.emplace_back(deck_title(deck));
+
+        current_deck_index = 0;
+        workspace.SwitchDeck(deck.Storage(), workspace.Decks().size(), 0);
+        shown_deck_index = 0;
+        replace_deck(false);
+    }, ButtonOption::Ascii());
+
+    auto deck_menu_option{MenuOption::Horizontal()};
+    deck_menu_option.on_change = [&] {
+        auto const from{static_cast<std::size_t>(shown_deck_index)};
+        workspace.SwitchDeck(deck.Storage(), from, current_deck_index);
+        deck_titles[from] = deck_title(workspace.Decks()[from]);
+        shown_deck_index = current_deck_index;
+        replace_deck(false);
+    };
+    auto const deck_menu = Menu(&deck_titles, &current_deck_index, deck_menu_option);
+
+    auto const import_markdown = Button("Import", [&] {
+        if (ImportSlidesFromFile(deck.Storage()))
+            replace_deck(true);
     }, ButtonOption::Ascii());
 
     auto const save_as = Button("Save As", [&] {
-        SaveSlides(slides);
+        auto const path{SaveSlides(deck.Storage())};
+        if (!path || !workspace.IsOpen())
+            return;
+
+        auto const shown{static_cast<std::size_t>(shown_deck_index)};
+        workspace.Saved(shown, *path, deck.Storage().slides);
+        deck_titles[shown] = deck_title(workspace.Decks()[shown]);
     }, ButtonOption::Ascii());
 
-    auto const tab_toggle = Toggle(&slide_titles, &current_slide_index);
+    std::shared_ptr<SlideNavigator> navigator;
+
+    // Moves the selected block so it starts at `to`, clamped to the deck.
+    auto const move_selection{[&](int to) {
+        auto const [first, count]{navigator->Selection()};
+        to = std::clamp(to, 0, static_cast<int>(deck.Size()) - count);
+        if (to == first)
+            return;
+
+        deck.Move(static_cast<std::size_t>(first), static_cast<std::size_t>(to), static_cast<std::size_t>(count));
+        navigator->SetSelection(to, count);
+        record(to);
+    }};
+
+    navigator = Make<SlideNavigator>(deck, current_slide_index, move_selection);
+
+    auto const duplicate = Button("Duplicate", [&] {
+        auto const [first, count]{navigator->Selection()};
+        auto const copies{static_cast<int>(deck.Duplicate(static_cast<std::size_t>(first), static_cast<std::size_t>(count)))};
+        navigator->SetSelection(copies, count);
+        record(copies);
+    }, ButtonOption::Ascii());
+    auto const move_up = Button("Move Up", [&] { move_selection(navigator->Selection().first - 1); }, ButtonOption::Ascii());
+    auto const move_down = Button("Move Down", [&] { move_selection(navigator->Selection().first + 1); }, ButtonOption::Ascii());
+
+    // The overview takes the place of the navigator and the editor. Thumbnails are drawn on the pool, each one
+    // finished redraws the grid.
+    ThumbnailCache thumbnails{pool, [&] { screen.PostEvent(Event::Custom); }};
+    int main_view{0};
+    auto const overview = Make<SlideOverview>(deck, current_slide_index, thumbnails, [&] {
+        main_view = 0;
+        editor->TakeFocus();
+    });
+    auto const overview_toggle = Button("Overview", [&] {
+        main_view = main_view == 0 ? 1 : 0;
+        if (main_view == 1)
+            overview->TakeFocus();
+    }, ButtonOption::Ascii());
+
+    // Ctrl+F or the Find button. Picking a match puts the cursor on it in the editor.
+    bool search_shown{false};
+    auto const search = Make<SearchPanel>(deck, [&](SearchMatch const &match) {
+        current_slide_index = static_cast<int>(match.slide);
+        editor->SetCursor(deck.Id(match.slide), {match.row, match.column});
+        search_shown = false;
+        main_view = 0;
+        editor->TakeFocus();
+    }, [&] { search_shown = false; });
+    auto const show_search{[&] {
+        search->Refresh();
+        search_shown = true;
+    }};
+    auto const find = Button("Find", show_search, ButtonOption::Ascii());
+
+    // A replace across the deck is one edit, however many slides it changes.
+    bool replace_shown{false};
+    auto const replace = Make<ReplacePanel>(deck, pool, [&](std::span<SlideReplacement const> replacements) {
+        if (ApplyReplace(deck, replacements) > 0)
+            record(current_slide_index);
+        replace_shown = false;
+    }, [&] { replace_shown = false; });
+    auto const show_replace = Button("Replace", [&] { replace_shown = true; }, ButtonOption::Ascii());
 
     auto const component = Container::Vertical({
         export_button,
+        patch_toggle,
+        run_rom,
         save_as,
         open,
+        open_folder,
+        import_markdown,
+        undo,
+        redo,
         big_text,
+        preview_toggle,
+        overview_toggle,
+        find,
+        show_replace,
         new_slide,
+        duplicate,
+        move_up,
+        move_down,
         delete_slide,
         reset,
-        tab_toggle,
-        tabs
+        deck_menu,
+        Container::Tab({
+            Container::Horizontal({
+                navigator,
+                editor
+            }),
+            overview
+        }, &main_view)
     });
 
+    Components const header_controls{
+        export_button, patch_toggle, run_rom, save_as, open, open_folder, import_markdown, undo, redo, big_text,
+        preview_toggle, overview_toggle, find, show_replace, new_slide, duplicate, move_up, move_down, delete_slide, reset
+    };
+
+    // The header and footer only change with focus, hover or the numbers they show, typing into the slide redraws
+    // nothing but the slide and the navigator.
+    CachedElement<HeaderKey> header;
+    CachedElement<FooterKey> footer;
+    Box header_box;
+    int mouse_x{-1};
+    int mouse_y{-1};
+
     auto renderer = Renderer(component, [&] {
-        auto const current_rows{std::ranges::count(std::as_const(*slides[current_slide_index]), '\n')};
-        bool does_exceed_max_rows{current_rows >= c_MaxRows - 1};
+        HeaderKey header_key{0, patch_format_index};
+        for (std::size_t i{0}; i < header_controls.size(); ++i)
+            header_key.focused |= header_controls[i]->Focused() ? 1u << i : 0u;
+        if (header_box.Contain(mouse_x, mouse_y)) {
+            header_key.mouse_x = mouse_x;
+            header_key.mouse_y = mouse_y;
+        }
 
-        return vbox({
-            hbox({
-                text("NESlides Editor"),
+        auto const header_element{header.Get(header_key, [&] {
+            Elements controls{text("NESlides Editor"), separator()};
+            for (auto const &control : header_controls)
+                controls.push_back(control->Render());
+            return hbox(std::move(controls)) | reflect(header_box);
+        })};
+
+        FooterKey const footer_key{deck.Metrics()[current_slide_index], deck.Metrics().Totals(), deck.Size(), exporting};
+        auto const footer_element{footer.Get(footer_key, [&] {
+            auto const &metrics{footer_key.slide};
+            auto const &totals{footer_key.totals};
+
+            return hbox({
+                text(std::format("{} rows remaining", std::max(c_MaxSlideLines - metrics.rows, 0))) | color(metrics.overflows ? Color::Red : Color::White),
                 separator(),
-                export_button->Render(),
-                save_as->Render(),
-                open->Render(),
-                big_text->Render(),
-                new_slide->Render(),
-                delete_slide->Render(),
-                reset->Render(),
+                text(std::format("{} B", metrics.encoded_size)),
                 separator(),
-                tab_toggle->Render()
-            }),
+                text(std::format("{} slides, {} rows", footer_key.slide_count, totals.rows)),
+                separator(),
+                CapacityMeter(totals.encoded_size, slide_capacity),
+                totals.overflowing_slides > 0
+                    ? text(std::format(" - {} slides overflow", totals.overflowing_slides)) | color(Color::Red)
+                    : emptyElement(),
+                footer_key.exporting ? text(" - Exporting...") : emptyElement()
+            });
+        })};
+
+        return vbox({
+            header_element,
+            workspace.IsOpen() ? vbox({separator(), deck_menu->Render()}) : emptyElement(),
             separator(),
-            tabs->Render() | size(WIDTH, EQUAL, c_MaxColumns ) | size(HEIGHT, EQUAL, c_MaxRows + 1),
-            text(std::format("{} rows remaining", c_MaxRows - current_rows - 2)) | color(does_exceed_max_rows ? Color::Red : Color::White)
+            main_view == 1
+                ? overview->Render() | size(HEIGHT, EQUAL, c_MaxRows + 2)
+                : hbox({
+                    navigator->Render() | size(WIDTH, EQUAL, c_NavigatorWidth),
+                    separator(),
+                    editor->Render() | size(WIDTH, EQUAL, c_MaxColumns + 2),
+                    show_preview
+                        ? hbox({separator(), preview.Render(deck[current_slide_index]) | size(WIDTH, EQUAL, c_PreviewWidth)})
+                        : emptyElement()
+                }) | size(HEIGHT, EQUAL, c_MaxRows + 2),
+            footer_element
         }) | border;
     });
 
+    renderer |= CatchEvent([&](Event event) {
+        if (event.is_mouse()) {
+            mouse_x = event.mouse().x;
+            mouse_y = event.mouse().y;
+        }
+        return false;
+    });
+
+    // Caught inside the modals, the deck must not change under a panel that is shown.
+    // Ctrl+U still undoes too, it was the binding while FTXUI kept Ctrl+Z for itself.
+    Event const undo_key{Event::Special("\x1A")};
+    Event const old_undo_key{Event::Special("\x15")};
+    Event const redo_key{Event::Special("\x12")};
+    Event const find_key{Event::Special("\x06")};
+    renderer |= CatchEvent([&](Event const &event) {
+        if (event == undo_key || event == old_undo_key || event == redo_key) {
+            restore(event == redo_key ? history.Redo() : history.Undo());
+            return true;
+        }
+        if (event == find_key) {
+            show_search();
+            return true;
+        }
+        return false;
+    });
+
+    // A paste is one edit, whatever its size. What fits goes into the current slide, the rest becomes new slides
+    // after it.
+    // Caught inside the modals, a panel that is shown gets the pasted text as typing instead.
+    renderer |= CatchPaste([&](std::string_view text) {
+        batching = true;
+        auto const consumed{editor->Paste(text)};
+        batching = false;
+
+        auto const inserted{PasteSlides(deck, static_cast<std::size_t>(current_slide_index), text.substr(consumed))};
+        if (consumed > 0 || inserted > 0)
+            record(current_slide_index);
+    });
+
     auto const success_modal{SuccessModal(hide_success)};
     auto const error_modal{ErrorModal(hide_error)};
 
     renderer |= Modal(success_modal, &success_shown);
     renderer |= Modal(error_modal, &error_shown);
+    renderer |= Modal(emulator, &emulator_shown);
+    renderer |= Modal(search, &search_shown);
+    renderer |= Modal(replace, &replace_shown);
+    // Not an undo while a panel is shown, but not a suspend either.
+    renderer |= CatchEvent([&](Event const &event) { return event == undo_key; });
+
+    if (EditorState state; LoadSession(c_SessionFileName, deck.Storage().slides, state, export_cache)) {
+        replace_deck(false);
+        for (std::size_t i{0}; i < deck.Size(); ++i)
+            editor->SetCursor(deck.Id(i), state.cursor_positions[i]);
+        current_slide_index = state.current_slide;
+    }
+
+    {
+        BracketedPasteMode const bracketed_paste;
+        screen.Loop(Instrument(renderer, frame_stats));
+    }
+
+    if (export_task.valid())
+        export_task.wait();
+    if (autosave.valid())
+        autosave.wait();
+
+    (void)SaveSession(c_SessionFileName, deck.Snapshot(), editor_state(), export_cache);
+    NESLIDES_WRITE_TRACE(c_TraceFileName);
 
-    screen.Loop(renderer);
     return 0;
 }
\ No newline at end of file
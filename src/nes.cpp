@@ -0,0 +1,391 @@
+#include "nes.h"
+
+#include <algorithm>
+
+namespace {
+    constexpr std::string_view c_InesMagic{"NES\x1A"};
+    constexpr std::size_t c_InesHeaderSize{16};
+    constexpr std::size_t c_TrainerSize{512};
+    constexpr std::size_t c_PrgBankSize{0x4000};
+    constexpr std::size_t c_ChrBankSize{0x2000};
+
+    constexpr int c_DotsPerScanline{341};
+    constexpr int c_ScanlinesPerFrame{262};
+    constexpr int c_VblankScanline{241};
+    constexpr int c_PreRenderScanline{261};
+    constexpr int c_OamDmaCycles{513};
+
+    constexpr std::uint8_t c_StatusSpriteOverflow{0x20};
+    constexpr std::uint8_t c_StatusSpriteZeroHit{0x40};
+    constexpr std::uint8_t c_StatusVblank{0x80};
+}
+
+Nes::Nes()
+    : cpu_{*this} {
+}
+
+bool Nes::Load(std::string_view rom) {
+    if (rom.size() < c_InesHeaderSize || !rom.starts_with(c_InesMagic))
+        return false;
+
+    auto const flags6{static_cast<std::uint8_t>(rom[6])};
+    auto const flags7{static_cast<std::uint8_t>(rom[7])};
+    if (((flags6 >> 4) | (flags7 & 0xF0)) != 0)
+        return false;
+
+    std::size_t const prg_size{static_cast<std::uint8_t>(rom[4]) * c_PrgBankSize};
+    std::size_t const chr_size{static_cast<std::uint8_t>(rom[5]) * c_ChrBankSize};
+    std::size_t const prg_offset{c_InesHeaderSize + ((flags6 & 0x04) != 0 ? c_TrainerSize : 0)};
+    if (prg_size == 0 || rom.size() < prg_offset + prg_size + chr_size)
+        return false;
+
+    auto const bytes{[&](std::size_t offset, std::size_t size) {
+        auto const data{reinterpret_cast<std::uint8_t const *>(rom.data() + offset)};
+        return std::vector<std::uint8_t>(data, data + size);
+    }};
+
+    prg_rom_ = bytes(prg_offset, prg_size);
+    chr_is_ram_ = chr_size == 0;
+    chr_ = chr_is_ram_ ? std::vector<std::uint8_t>(c_ChrBankSize) : bytes(prg_offset + prg_size, chr_size);
+    vertical_mirroring_ = (flags6 & 0x01) != 0;
+
+    ram_.fill(0);
+    prg_ram_.fill(0);
+    nametables_.fill(0);
+    palette_.fill(0);
+    oam_.fill(0);
+    frame_.fill(0);
+    frame_count_ = 0;
+
+    Reset();
+    return true;
+}
+
+void Nes::Reset() {
+    control_ = 0;
+    mask_ = 0;
+    status_ = 0;
+    write_toggle_ = false;
+    v_ = 0;
+    t_ = 0;
+    fine_x_ = 0;
+    scanline_ = 0;
+    dot_ = 0;
+    stall_cycles_ = 0;
+    cpu_.Reset();
+}
+
+void Nes::RunFrame() {
+    if (prg_rom_.empty())
+        return;
+
+    frame_done_ = false;
+    while (!frame_done_) {
+        int const cycles{cpu_.Step() + stall_cycles_};
+        stall_cycles_ = 0;
+        Tick(cycles);
+    }
+}
+
+std::uint8_t Nes::Read(std::uint16_t address) {
+    if (address < 0x2000)
+        return ram_[address & 0x07FF];
+
+    if (address < 0x4000)
+        return ReadRegister(static_cast<std::uint16_t>(0x2000 | (address & 0x0007)));
+
+    if (address == 0x4016) {
+        std::uint8_t const bit{static_cast<std::uint8_t>((strobe_ ? buttons_ : shift_register_) & 0x01)};
+        if (!strobe_)
+            shift_register_ = static_cast<std::uint8_t>(shift_register_ >> 1 | 0x80);
+        return static_cast<std::uint8_t>(0x40 | bit);
+    }
+
+    if (address < 0x6000)
+        return 0;
+
+    if (address < 0x8000)
+        return prg_ram_[address - 0x6000];
+
+    return prg_rom_[(address - 0x8000) % prg_rom_.size()];
+}
+
+void Nes::Write(std::uint16_t address, std::uint8_t value) {
+    if (address < 0x2000) {
+        ram_[address & 0x07FF] = value;
+    } else if (address < 0x4000) {
+        WriteRegister(static_cast<std::uint16_t>(0x2000 | (address & 0x0007)), value);
+    } else if (address == 0x4014) {
+        for (int i{0}; i < 0x100; ++i)
+            oam_[static_cast<std::uint8_t>(oam_address_ + i)] = Read(static_cast<std::uint16_t>(value << 8 | i));
+        stall_cycles_ += c_OamDmaCycles;
+    } else if (address == 0x4016) {
+        strobe_ = (value & 0x01) != 0;
+        shift_register_ = buttons_;
+    } else if (address >= 0x6000 && address < 0x8000) {
+        prg_ram_[address - 0x6000] = value;
+    }
+}
+
+std::uint8_t Nes::ReadRegister(std::uint16_t address) {
+    switch (address) {
+    case 0x2002: {
+        auto const result{static_cast<std::uint8_t>((status_ & 0xE0) | (read_buffer_ & 0x1F))};
+        status_ &= static_cast<std::uint8_t>(~c_StatusVblank);
+        write_toggle_ = false;
+        return result;
+    }
+    case 0x2004:
+        return oam_[oam_address_];
+    case 0x2007: {
+        auto const vram_address{static_cast<std::uint16_t>(v_ & 0x3FFF)};
+        std::uint8_t result{read_buffer_};
+        // Palette reads are immediate, the buffer gets the nametable byte underneath.
+        if (vram_address >= 0x3F00) {
+            result = ReadVram(vram_address);
+            read_buffer_ = ReadVram(static_cast<std::uint16_t>(vram_address - 0x1000));
+        } else {
+            read_buffer_ = ReadVram(vram_address);
+        }
+        v_ = static_cast<std::uint16_t>(v_ + ((control_ & 0x04) != 0 ? 32 : 1));
+        return result;
+    }
+    default:
+        return 0;
+    }
+}
+
+void Nes::WriteRegister(std::uint16_t address, std::uint8_t value) {
+    switch (address) {
+    case 0x2000: {
+        bool const nmi_was_enabled{(control_ & 0x80) != 0};
+        control_ = value;
+        t_ = static_cast<std::uint16_t>((t_ & ~0x0C00) | (value & 0x03) << 10);
+        // Enabling NMI during vblank raises one straight away.
+        if (!nmi_was_enabled && (value & 0x80) != 0 && (status_ & c_StatusVblank) != 0)
+            cpu_.RequestNmi();
+        break;
+    }
+    case 0x2001:
+        mask_ = value;
+        break;
+    case 0x2003:
+        oam_address_ = value;
+        break;
+    case 0x2004:
+        oam_[oam_address_++] = value;
+        break;
+    case 0x2005:
+        if (!write_toggle_) {
+            t_ = static_cast<std::uint16_t>((t_ & ~0x001F) | value >> 3);
+            fine_x_ = value & 0x07;
+        } else {
+            t_ = static_cast<std::uint16_t>((t_ & ~0x73E0) | (value & 0x07) << 12 | (value & 0xF8) << 2);
+        }
+        write_toggle_ = !write_toggle_;
+        break;
+    case 0x2006:
+        if (!write_toggle_) {
+            t_ = static_cast<std::uint16_t>((t_ & 0x00FF) | (value & 0x3F) << 8);
+        } else {
+            t_ = static_cast<std::uint16_t>((t_ & 0xFF00) | value);
+            v_ = t_;
+        }
+        write_toggle_ = !write_toggle_;
+        break;
+    case 0x2007:
+        WriteVram(static_cast<std::uint16_t>(v_ & 0x3FFF), value);
+        v_ = static_cast<std::uint16_t>(v_ + ((control_ & 0x04) != 0 ? 32 : 1));
+        break;
+    default:
+        break;
+    }
+}
+
+std::size_t Nes::NametableIndex(std::uint16_t address) const noexcept {
+    std::size_t const offset{static_cast<std::size_t>(address - 0x2000) & 0x0FFF};
+    std::size_t const table{offset / 0x400};
+    std::size_t const physical{vertical_mirroring_ ? table & 1 : table >> 1};
+    return physical * 0x400 + (offset & 0x03FF);
+}
+
+std::size_t Nes::PaletteIndex(std::uint16_t address) noexcept {
+    std::size_t index{address & 0x1Fu};
+    // The backdrop entries of the sprite palettes mirror the background ones.
+    if (index >= 0x10 && (index & 0x03) == 0)
+        index -= 0x10;
+    return index;
+}
+
+std::uint8_t Nes::ReadVram(std::uint16_t address) const {
+    if (address < 0x2000)
+        return chr_[address % chr_.size()];
+    if (address < 0x3F00)
+        return nametables_[NametableIndex(address)];
+    return palette_[PaletteIndex(address)];
+}
+
+void Nes::WriteVram(std::uint16_t address, std::uint8_t value) {
+    if (address < 0x2000) {
+        if (chr_is_ram_)
+            chr_[address % chr_.size()] = value;
+    } else if (address < 0x3F00) {
+        nametables_[NametableIndex(address)] = value;
+    } else {
+        palette_[PaletteIndex(address)] = value;
+    }
+}
+
+void Nes::Tick(int cycles) {
+    // Nothing happens between these dots, so the PPU skips from one to the next.
+    constexpr std::array<int, 5> c_EventDots{1, 256, 257, 304, c_DotsPerScanline};
+
+    for (int dots{cycles * 3}; dots > 0;) {
+        bool const visible{scanline_ < c_NesHeight};
+
+        if (visible && dot_ == 256) {
+            RenderScanline();
+            if (RenderingEnabled())
+                IncrementY();
+        } else if ((visible || scanline_ == c_PreRenderScanline) && dot_ == 257 && RenderingEnabled()) {
+            v_ = static_cast<std::uint16_t>((v_ & ~0x041F) | (t_ & 0x041F));
+        } else if (scanline_ == c_PreRenderScanline && dot_ == 304 && RenderingEnabled()) {
+            v_ = static_cast<std::uint16_t>((v_ & ~0x7BE0) | (t_ & 0x7BE0));
+        } else if (scanline_ == c_VblankScanline && dot_ == 1) {
+            status_ |= c_StatusVblank;
+            if ((control_ & 0x80) != 0)
+                cpu_.RequestNmi();
+            frame_done_ = true;
+            ++frame_count_;
+        } else if (scanline_ == c_PreRenderScanline && dot_ == 1) {
+            status_ &= static_cast<std::uint8_t>(~(c_StatusVblank | c_StatusSpriteZeroHit | c_StatusSpriteOverflow));
+        }
+
+        int const next{*std::ranges::upper_bound(c_EventDots, dot_)};
+        int const step{std::min(dots, next - dot_)};
+        dots -= step;
+        dot_ += step;
+        if (dot_ == c_DotsPerScanline) {
+            dot_ = 0;
+            if (++scanline_ == c_ScanlinesPerFrame)
+                scanline_ = 0;
+        }
+    }
+}
+
+void Nes::IncrementY() noexcept {
+    if ((v_ & 0x7000) != 0x7000) {
+        v_ = static_cast<std::uint16_t>(v_ + 0x1000);
+        return;
+    }
+
+    v_ &= static_cast<std::uint16_t>(~0x7000);
+    int coarse_y{(v_ & 0x03E0) >> 5};
+    if (coarse_y == 29) {
+        coarse_y = 0;
+        v_ ^= 0x0800;
+    } else if (coarse_y == 31) {
+        coarse_y = 0;
+    } else {
+        ++coarse_y;
+    }
+    v_ = static_cast<std::uint16_t>((v_ & ~0x03E0) | coarse_y << 5);
+}
+
+void Nes::RenderScanline() {
+    auto *const line{frame_.data() + static_cast<std::ptrdiff_t>(scanline_) * c_NesWidth};
+    // Palette RAM indices, 0 where nothing is drawn.
+    std::array<std::uint8_t, c_NesWidth> indices{};
+    std::array<bool, c_NesWidth> background_opaque{};
+
+    bool const show_background{(mask_ & 0x08) != 0};
+    bool const show_sprites{(mask_ & 0x10) != 0};
+
+    if (show_background) {
+        std::uint16_t v{v_};
+        int fine_x{fine_x_};
+        std::uint8_t low{0};
+        std::uint8_t high{0};
+        std::uint8_t attribute{0};
+
+        for (int x{0}; x < c_NesWidth; ++x) {
+            if (x == 0 || fine_x == 0) {
+                std::uint8_t const tile{ReadVram(static_cast<std::uint16_t>(0x2000 | (v & 0x0FFF)))};
+                std::uint8_t const attributes{ReadVram(static_cast<std::uint16_t>(0x23C0 | (v & 0x0C00) | ((v >> 4) & 0x38) | ((v >> 2) & 0x07)))};
+                attribute = static_cast<std::uint8_t>((attributes >> (((v >> 4) & 0x04) | (v & 0x02))) & 0x03);
+                auto const pattern{static_cast<std::uint16_t>(((control_ & 0x10) != 0 ? 0x1000 : 0) + tile * 16 + ((v >> 12) & 0x07))};
+                low = ReadVram(pattern);
+                high = ReadVram(static_cast<std::uint16_t>(pattern + 8));
+            }
+
+            int const bit{7 - fine_x};
+            auto const pixel{static_cast<std::uint8_t>(((low >> bit) & 0x01) | ((high >> bit) & 0x01) << 1)};
+            if (pixel != 0 && (x >= 8 || (mask_ & 0x02) != 0)) {
+                indices[x] = static_cast<std::uint8_t>(attribute * 4 + pixel);
+                background_opaque[x] = true;
+            }
+
+            if (++fine_x == 8) {
+                fine_x = 0;
+                if ((v & 0x001F) == 31) {
+                    v = static_cast<std::uint16_t>((v & ~0x001F) ^ 0x0400);
+                } else {
+                    ++v;
+                }
+            }
+        }
+    }
+
+    if (show_sprites) {
+        int const height{(control_ & 0x20) != 0 ? 16 : 8};
+        std::array<bool, c_NesWidth> sprite_drawn{};
+        int found{0};
+
+        for (int sprite{0}; sprite < 64; ++sprite) {
+            auto const *const entry{oam_.data() + sprite * 4};
+            int row{scanline_ - entry[0] - 1};
+            if (row < 0 || row >= height)
+                continue;
+
+            if (++found > 8) {
+                status_ |= c_StatusSpriteOverflow;
+                break;
+            }
+
+            std::uint8_t const tile{entry[1]};
+            std::uint8_t const attributes{entry[2]};
+            if ((attributes & 0x80) != 0)
+                row = height - 1 - row;
+
+            std::uint16_t pattern{};
+            if (height == 8) {
+                pattern = static_cast<std::uint16_t>(((control_ & 0x08) != 0 ? 0x1000 : 0) + tile * 16 + row);
+            } else {
+                pattern = static_cast<std::uint16_t>(((tile & 0x01) != 0 ? 0x1000 : 0) + (tile & 0xFE) * 16 + (row >= 8 ? row + 8 : row));
+            }
+            std::uint8_t const low{ReadVram(pattern)};
+            std::uint8_t const high{ReadVram(static_cast<std::uint16_t>(pattern + 8))};
+
+            for (int column{0}; column < 8; ++column) {
+                int const x{entry[3] + column};
+                if (x >= c_NesWidth)
+                    break;
+
+                int const bit{(attributes & 0x40) != 0 ? column : 7 - column};
+                auto const pixel{static_cast<std::uint8_t>(((low >> bit) & 0x01) | ((high >> bit) & 0x01) << 1)};
+                if (pixel == 0 || sprite_drawn[x] || (x < 8 && (mask_ & 0x04) == 0))
+                    continue;
+
+                // Lower sprites win over higher ones even when they are behind the background.
+                sprite_drawn[x] = true;
+                if (sprite == 0 && background_opaque[x] && x != 255)
+                    status_ |= c_StatusSpriteZeroHit;
+                if ((attributes & 0x20) == 0 || !background_opaque[x])
+                    indices[x] = static_cast<std::uint8_t>(0x10 + (attributes & 0x03) * 4 + pixel);
+            }
+        }
+    }
+
+    for (int x{0}; x < c_NesWidth; ++x)
+        line[x] = palette_[PaletteIndex(indices[x])] & 0x3F;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "cpu6502.h"
+
+constexpr int c_NesWidth{256};
+constexpr int c_NesHeight{240};
+
+// Standard controller buttons, in the order the shift register reports them.
+enum NesButton : std::uint8_t {
+    NesButtonA = 1 << 0,
+    NesButtonB = 1 << 1,
+    NesButtonSelect = 1 << 2,
+    NesButtonStart = 1 << 3,
+    NesButtonUp = 1 << 4,
+    NesButtonDown = 1 << 5,
+    NesButtonLeft = 1 << 6,
+    NesButtonRight = 1 << 7
+};
+
+// A headless NES for NROM cartridges, enough to boot the exported ROM: the CPU, 2 KB of RAM, PRG RAM, the PPU and
+// controller one. There is no APU, writes to it are ignored.
+//
+// The PPU draws a whole scanline at a time with the scroll at that point, so mid-frame scroll splits land on the
+// right line but not the right dot. Sprite 0 hit is set on the line it happens.
+class Nes final : private CpuBus {
+public:
+    // NES colour numbers, 0 to 63, one per pixel.
+    using Frame = std::array<std::uint8_t, c_NesWidth * c_NesHeight>;
+
+    Nes();
+
+    Nes(Nes const &) = delete;
+    Nes &operator=(Nes const &) = delete;
+
+    // Loads an iNES image and resets. Fails for anything but mapper 0.
+    [[nodiscard]]
+    bool Load(std::string_view rom);
+
+    void Reset();
+
+    // Runs until the PPU finished the next frame.
+    void RunFrame();
+
+    void SetButtons(std::uint8_t buttons) noexcept {
+        buttons_ = buttons;
+    }
+
+    [[nodiscard]]
+    Frame const &Picture() const noexcept {
+        return frame_;
+    }
+
+    // The colour shown where nothing is drawn.
+    [[nodiscard]]
+    std::uint8_t Backdrop() const noexcept {
+        return palette_[0] & 0x3F;
+    }
+
+    [[nodiscard]]
+    std::uint64_t FrameCount() const noexcept {
+        return frame_count_;
+    }
+
+private:
+    Cpu6502 cpu_;
+
+    std::vector<std::uint8_t> prg_rom_;
+    std::vector<std::uint8_t> chr_;
+    bool chr_is_ram_{false};
+    bool vertical_mirroring_{false};
+
+    std::array<std::uint8_t, 0x800> ram_{};
+    std::array<std::uint8_t, 0x2000> prg_ram_{};
+
+    std::array<std::uint8_t, 0x800> nametables_{};
+    std::array<std::uint8_t, 0x20> palette_{};
+    std::array<std::uint8_t, 0x100> oam_{};
+    std::uint8_t oam_address_{0};
+
+    std::uint8_t control_{0};
+    std::uint8_t mask_{0};
+    std::uint8_t status_{0};
+    std::uint8_t read_buffer_{0};
+    // The scroll registers as the hardware keeps them: the current and temporary VRAM address, fine X and the write
+    // toggle shared by PPUSCROLL and PPUADDR.
+    std::uint16_t v_{0};
+    std::uint16_t t_{0};
+    std::uint8_t fine_x_{0};
+    bool write_toggle_{false};
+
+    int scanline_{0};
+    int dot_{0};
+    bool frame_done_{false};
+    std::uint64_t frame_count_{0};
+    Frame frame_{};
+
+    // CPU cycles taken from the next instruction by OAM DMA.
+    int stall_cycles_{0};
+
+    std::uint8_t buttons_{0};
+    std::uint8_t shift_register_{0};
+    bool strobe_{false};
+
+    std::uint8_t Read(std::uint16_t address) override;
+    void Write(std::uint16_t address, std::uint8_t value) override;
+
+    [[nodiscard]]
+    std::uint8_t ReadRegister(std::uint16_t address);
+    void WriteRegister(std::uint16_t address, std::uint8_t value);
+
+    [[nodiscard]]
+    std::uint8_t ReadVram(std::uint16_t address) const;
+    void WriteVram(std::uint16_t address, std::uint8_t value);
+    [[nodiscard]]
+    std::size_t NametableIndex(std::uint16_t address) const noexcept;
+    [[nodiscard]]
+    static std::size_t PaletteIndex(std::uint16_t address) noexcept;
+
+    [[nodiscard]]
+    bool RenderingEnabled() const noexcept {
+        return (mask_ & 0x18) != 0;
+    }
+
+    void Tick(int cycles);
+    void RenderScanline();
+    void IncrementY() noexcept;
+};
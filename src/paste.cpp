@@ -0,0 +1,169 @@
+#include "paste.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ftxui/dom/node.hpp>
+#include <ftxui/screen/screen.hpp>
+
+#include "deck.h"
+#include "grid_input.h"
+#include "importer.h"
+
+namespace {
+    constexpr std::string_view c_BracketedPasteOn{"\x1B[?2004h"};
+    constexpr std::string_view c_BracketedPasteOff{"\x1B[?2004l"};
+
+    constexpr std::size_t c_BenchmarkPasteSize{50 * 1024};
+
+    using Clock = std::chrono::steady_clock;
+
+    [[nodiscard]]
+    double MillisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    [[nodiscard]]
+    std::string MakePasteBlock(std::size_t size) {
+        constexpr std::string_view line{"the quick brown fox jumps\nover the lazy dog\n\n"};
+
+        std::string block;
+        block.reserve(size);
+        while (block.size() < size)
+            block.append(line.substr(0, size - block.size()));
+
+        return block;
+    }
+
+    void RenderFrame(ftxui::Component const &component) {
+        auto screen{ftxui::Screen::Create(ftxui::Dimension::Fixed(80), ftxui::Dimension::Fixed(c_MaxRows + 2))};
+        ftxui::Render(screen, component->Render());
+    }
+}
+
+BracketedPasteMode::BracketedPasteMode() {
+    std::cout << c_BracketedPasteOn << std::flush;
+}
+
+BracketedPasteMode::~BracketedPasteMode() {
+    std::cout << c_BracketedPasteOff << std::flush;
+}
+
+ftxui::ComponentDecorator CatchPaste(std::function<void(std::string_view)> on_paste) {
+    using ftxui::Event;
+
+    struct State final {
+        bool pasting{false};
+        bool after_return{false};
+        std::string text;
+    };
+
+    return ftxui::CatchEvent([state = std::make_shared<State>(), on_paste = std::move(on_paste)](Event event) {
+        if (event == Event::Special(std::string{c_PasteStart})) {
+            state->pasting = true;
+            state->after_return = false;
+            state->text.clear();
+            return true;
+        }
+
+        if (!state->pasting)
+            return false;
+
+        if (event == Event::Special(std::string{c_PasteEnd})) {
+            state->pasting = false;
+            on_paste(state->text);
+            return true;
+        }
+
+        for (char const c : event.input()) {
+            // A CR LF pair is one line break.
+            bool const line_feed_after_return{c == '\n' && state->after_return};
+            state->after_return = c == '\r';
+            if (!line_feed_after_return)
+                state->text += c == '\r' ? '\n' : c == '\t' ? ' ' : c;
+        }
+        return true;
+    });
+}
+
+std::size_t PasteSlides(Deck &deck, std::size_t after, std::string_view text) {
+    if (text.empty())
+        return 0;
+
+    std::istringstream input{std::string{text}};
+    Slides const slides{ImportSlides(input, ImportFormat::PlainText)};
+    for (std::size_t i{0}; i < slides.size(); ++i)
+        (void)deck.Insert(after + 1 + i, slides[i]);
+
+    return slides.size();
+}
+
+int RunPasteBenchmark() {
+    using ftxui::Event;
+
+    std::string const block{MakePasteBlock(c_BenchmarkPasteSize)};
+
+    // The slides a paste of the block ends up as, so that typing does the same work: a full slide takes no more keys,
+    // typing carries on in a new slide where the paste breaks.
+    std::vector<std::string> slide_texts;
+    {
+        Deck deck;
+        int current{0};
+        GridInput editor{deck, current, [&](std::size_t slide) { deck.Edited(slide); }};
+        (void)PasteSlides(deck, 0, std::string_view{block}.substr(editor.Paste(block)));
+        for (std::size_t i{0}; i < deck.Size(); ++i)
+            slide_texts.push_back(deck[i].Text());
+    }
+
+    {
+        Deck deck;
+        int current{0};
+        auto const editor{ftxui::Make<GridInput>(deck, current, [&](std::size_t slide) { deck.Edited(slide); })};
+        std::size_t keys{0};
+
+        auto const start{Clock::now()};
+        for (std::size_t slide{0}; slide < slide_texts.size(); ++slide) {
+            if (slide > 0)
+                current = static_cast<int>(deck.Insert(slide));
+
+            for (char const c : slide_texts[slide]) {
+                editor->OnEvent(c == '\n' ? Event::Return : Event::Character(c));
+                RenderFrame(editor);
+                ++keys;
+            }
+        }
+        double const elapsed{MillisecondsSince(start)};
+
+        std::cout << std::format("typed: {} events and frames into {} slides in {:.3f} ms, {:.3f} us per key\n", keys,
+                                 deck.Size(), elapsed, elapsed * 1000.0 / static_cast<double>(std::max<std::size_t>(keys, 1)));
+    }
+
+    {
+        Deck deck;
+        int current{0};
+        auto const editor{ftxui::Make<GridInput>(deck, current, [&](std::size_t slide) { deck.Edited(slide); })};
+        std::size_t inserted{0};
+        auto const component{editor | CatchPaste([&](std::string_view text) {
+            auto const consumed{editor->Paste(text)};
+            inserted = PasteSlides(deck, static_cast<std::size_t>(current), text.substr(consumed));
+        })};
+
+        auto const start{Clock::now()};
+        component->OnEvent(Event::Special(std::string{c_PasteStart}));
+        for (char const c : block)
+            component->OnEvent(c == '\n' ? Event::Return : Event::Character(c));
+        component->OnEvent(Event::Special(std::string{c_PasteEnd}));
+        RenderFrame(component);
+        double const elapsed{MillisecondsSince(start)};
+
+        std::cout << std::format("bracketed paste: 1 edit and 1 frame in {:.3f} ms, {} slides added\n", elapsed, inserted);
+    }
+
+    return 0;
+}
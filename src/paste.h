@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+#include <ftxui/component/component.hpp>
+
+class Deck;
+
+// Terminals wrap pasted text in these once bracketed paste mode is on.
+constexpr std::string_view c_PasteStart{"\x1B[200~"};
+constexpr std::string_view c_PasteEnd{"\x1B[201~"};
+
+// Turns the terminal's bracketed paste mode on for its lifetime. FTXUI leaves it off, and without it a paste arrives
+// as one keystroke per character.
+class BracketedPasteMode final {
+public:
+    BracketedPasteMode();
+    ~BracketedPasteMode();
+
+    BracketedPasteMode(BracketedPasteMode const &) = delete;
+    BracketedPasteMode &operator=(BracketedPasteMode const &) = delete;
+};
+
+// Collects every event between the paste markers and hands their text to `on_paste` in one piece, with line endings
+// turned into '\n' and tabs into spaces. The decorated component sees none of them.
+[[nodiscard]]
+ftxui::ComponentDecorator CatchPaste(std::function<void(std::string_view)> on_paste);
+
+// Imports what did not fit into the slide it was pasted in as plain text, inserting the slides after `after`.
+// Returns the number of slides inserted.
+std::size_t PasteSlides(Deck &deck, std::size_t after, std::string_view text);
+
+// Enters a 50 KB block once as typed keystrokes, rendering after each, and once as a bracketed paste, and prints the
+// latency of each. The keystrokes type the same slides the paste produces, a new slide where the paste breaks.
+int RunPasteBenchmark();
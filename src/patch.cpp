@@ -0,0 +1,520 @@
+#include "patch.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace {
+    constexpr std::string_view c_IpsHeader{"PATCH"};
+    constexpr std::string_view c_IpsFooter{"EOF"};
+    constexpr std::size_t c_IpsMaxOffset{0xFFFFFF};
+    constexpr std::size_t c_IpsMaxRecord{0xFFFF};
+    // Offset that would read as the footer, records must not start there.
+    constexpr std::size_t c_IpsFooterOffset{0x454F46};
+    // A record costs 5 bytes, equal bytes shorter than that are cheaper to include than to split the record over.
+    constexpr std::size_t c_IpsRecordOverhead{5};
+
+    constexpr std::string_view c_BpsHeader{"BPS1"};
+    constexpr std::size_t c_BpsFooterSize{12};
+
+    enum BpsAction : std::uint64_t {
+        SourceRead = 0,
+        TargetRead = 1,
+        SourceCopy = 2,
+        TargetCopy = 3
+    };
+
+    [[nodiscard]]
+    constexpr std::array<std::uint32_t, 256> MakeCrc32Table() {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t i{0}; i < table.size(); ++i) {
+            std::uint32_t crc{i};
+            for (int bit{0}; bit < 8; ++bit)
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            table[i] = crc;
+        }
+
+        return table;
+    }
+
+    constexpr auto c_Crc32Table{MakeCrc32Table()};
+
+    [[nodiscard]]
+    std::uint32_t Crc32(std::string_view bytes) {
+        std::uint32_t crc{0xFFFFFFFFu};
+        for (char const c : bytes)
+            crc = c_Crc32Table[(crc ^ static_cast<unsigned char>(c)) & 0xFF] ^ (crc >> 8);
+
+        return ~crc;
+    }
+
+    [[nodiscard]]
+    std::uint8_t Byte(std::string_view bytes, std::size_t index) {
+        return static_cast<std::uint8_t>(bytes[index]);
+    }
+
+    void PutBigEndian(std::string &out, std::size_t value, int size) {
+        for (int shift{(size - 1) * 8}; shift >= 0; shift -= 8)
+            out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+
+    [[nodiscard]]
+    std::size_t GetBigEndian(std::string_view bytes, std::size_t offset, int size) {
+        std::size_t value{0};
+        for (int i{0}; i < size; ++i)
+            value = (value << 8) | Byte(bytes, offset + i);
+
+        return value;
+    }
+
+    void PutLittleEndian32(std::string &out, std::uint32_t value) {
+        for (int shift{0}; shift < 32; shift += 8)
+            out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+
+    void PutNumber(std::string &out, std::uint64_t value) {
+        while (true) {
+            std::uint8_t const low{static_cast<std::uint8_t>(value & 0x7F)};
+            value >>= 7;
+            if (value == 0) {
+                out.push_back(static_cast<char>(0x80 | low));
+                return;
+            }
+            out.push_back(static_cast<char>(low));
+            --value;
+        }
+    }
+
+    [[nodiscard]]
+    bool GetNumber(std::string_view bytes, std::size_t &offset, std::uint64_t &value) {
+        value = 0;
+        std::uint64_t shift{1};
+        while (offset < bytes.size()) {
+            std::uint8_t const x{Byte(bytes, offset++)};
+            value += (x & 0x7F) * shift;
+            if (x & 0x80)
+                return true;
+
+            shift <<= 7;
+            value += shift;
+        }
+
+        return false;
+    }
+
+    [[nodiscard]]
+    std::size_t MatchLength(std::string_view a, std::size_t a_offset, std::string_view b, std::size_t b_offset) {
+        std::size_t length{0};
+        while (a_offset + length < a.size() && b_offset + length < b.size() && a[a_offset + length] == b[b_offset + length])
+            ++length;
+
+        return length;
+    }
+
+    // Rabin-Karp hashes of every c_Window byte window, each rolled from the previous one in constant time.
+    constexpr std::size_t c_Window{8};
+    constexpr std::uint32_t c_HashBase{257};
+    constexpr int c_BucketBits{16};
+    constexpr std::uint32_t c_NoPosition{0xFFFFFFFFu};
+    constexpr int c_MaxChainLength{32};
+
+    [[nodiscard]]
+    std::vector<std::uint32_t> RollingHashes(std::string_view bytes) {
+        std::vector<std::uint32_t> hashes;
+        if (bytes.size() < c_Window)
+            return hashes;
+
+        std::uint32_t top_power{1};
+        for (std::size_t i{1}; i < c_Window; ++i)
+            top_power *= c_HashBase;
+
+        hashes.resize(bytes.size() - c_Window + 1);
+        std::uint32_t hash{0};
+        for (std::size_t i{0}; i < c_Window; ++i)
+            hash = hash * c_HashBase + Byte(bytes, i);
+        hashes[0] = hash;
+
+        for (std::size_t i{1}; i < hashes.size(); ++i) {
+            hash = (hash - Byte(bytes, i - 1) * top_power) * c_HashBase + Byte(bytes, i + c_Window - 1);
+            hashes[i] = hash;
+        }
+
+        return hashes;
+    }
+
+    [[nodiscard]]
+    std::uint32_t Bucket(std::uint32_t hash) {
+        return (hash * 0x9E3779B1u) >> (32 - c_BucketBits);
+    }
+
+    // Hash chains over window positions, newest position first.
+    class MatchIndex final {
+    public:
+        explicit MatchIndex(std::size_t positions)
+            : heads_(std::size_t{1} << c_BucketBits, c_NoPosition)
+            , next_(positions, c_NoPosition) {
+        }
+
+        void Insert(std::uint32_t hash, std::size_t position) {
+            auto &head{heads_[Bucket(hash)]};
+            next_[position] = head;
+            head = static_cast<std::uint32_t>(position);
+        }
+
+        template<typename Function>
+        void ForEachCandidate(std::uint32_t hash, Function function) const {
+            int chain{0};
+            for (auto position{heads_[Bucket(hash)]}; position != c_NoPosition && chain < c_MaxChainLength; position = next_[position], ++chain)
+                function(position);
+        }
+
+    private:
+        std::vector<std::uint32_t> heads_;
+        std::vector<std::uint32_t> next_;
+    };
+
+    class BpsEncoder final {
+    public:
+        explicit BpsEncoder(std::string &out)
+            : out_{out} {
+        }
+
+        void Literal(std::string_view target, std::size_t from, std::size_t to) {
+            if (from == to)
+                return;
+
+            PutNumber(out_, ((to - from - 1) << 2) | TargetRead);
+            out_.append(target.substr(from, to - from));
+        }
+
+        void Read(std::size_t length) {
+            PutNumber(out_, ((length - 1) << 2) | SourceRead);
+        }
+
+        void Copy(BpsAction action, std::size_t offset, std::size_t length) {
+            auto &relative_offset{action == SourceCopy ? source_relative_offset_ : target_relative_offset_};
+            auto const delta{static_cast<std::int64_t>(offset) - static_cast<std::int64_t>(relative_offset)};
+
+            PutNumber(out_, ((length - 1) << 2) | action);
+            PutNumber(out_, (static_cast<std::uint64_t>(delta < 0 ? -delta : delta) << 1) | (delta < 0 ? 1 : 0));
+            relative_offset = offset + length;
+        }
+
+    private:
+        std::string &out_;
+        std::size_t source_relative_offset_{0};
+        std::size_t target_relative_offset_{0};
+    };
+}
+
+std::string_view PatchExtension(PatchFormat format) noexcept {
+    switch (format) {
+        case PatchFormat::Ips:
+            return ".ips";
+        case PatchFormat::Bps:
+            return ".bps";
+        case PatchFormat::None:
+            break;
+    }
+
+    return {};
+}
+
+std::optional<std::string> CreateIpsPatch(std::string_view source, std::string_view target) {
+    if (target.size() > c_IpsMaxOffset + 1)
+        return std::nullopt;
+
+    std::string patch{c_IpsHeader};
+
+    auto const differs{[&](std::size_t offset) {
+        return offset >= source.size() || source[offset] != target[offset];
+    }};
+
+    std::size_t offset{0};
+    while (offset < target.size()) {
+        if (!differs(offset)) {
+            ++offset;
+            continue;
+        }
+
+        std::size_t start{offset};
+        if (start == c_IpsFooterOffset)
+            --start;
+
+        // Grow the record over short equal stretches, they cost less than a new record header.
+        std::size_t end{offset + 1};
+        while (end < target.size() && end - start < c_IpsMaxRecord) {
+            if (differs(end)) {
+                ++end;
+                continue;
+            }
+
+            std::size_t next_difference{end};
+            while (next_difference < target.size() && next_difference - end <= c_IpsRecordOverhead && !differs(next_difference))
+                ++next_difference;
+
+            if (next_difference == target.size() || next_difference - end > c_IpsRecordOverhead)
+                break;
+
+            end = std::min(next_difference, start + c_IpsMaxRecord);
+        }
+
+        std::string_view const data{target.substr(start, end - start)};
+        bool const is_run{data.size() > 8 && std::ranges::all_of(data, [&](char c) { return c == data.front(); })};
+
+        PutBigEndian(patch, start, 3);
+        if (is_run) {
+            PutBigEndian(patch, 0, 2);
+            PutBigEndian(patch, data.size(), 2);
+            patch.push_back(data.front());
+        } else {
+            PutBigEndian(patch, data.size(), 2);
+            patch.append(data);
+        }
+
+        offset = end;
+    }
+
+    patch.append(c_IpsFooter);
+    if (target.size() < source.size())
+        PutBigEndian(patch, target.size(), 3);
+
+    return patch;
+}
+
+std::string CreateBpsPatch(std::string_view source, std::string_view target) {
+    std::string patch{c_BpsHeader};
+    PutNumber(patch, source.size());
+    PutNumber(patch, target.size());
+    PutNumber(patch, 0);
+
+    std::vector<std::uint32_t> const source_hashes{RollingHashes(source)};
+    std::vector<std::uint32_t> const target_hashes{RollingHashes(target)};
+
+    MatchIndex source_index{source_hashes.size()};
+    for (std::size_t position{source_hashes.size()}; position-- > 0;)
+        source_index.Insert(source_hashes[position], position);
+
+    MatchIndex target_index{target_hashes.size()};
+    std::size_t indexed_target{0};
+    auto const index_target_until{[&](std::size_t end) {
+        for (; indexed_target < std::min(end, target_hashes.size()); ++indexed_target)
+            target_index.Insert(target_hashes[indexed_target], indexed_target);
+    }};
+
+    BpsEncoder encoder{patch};
+    std::size_t literal_start{0};
+    std::size_t position{0};
+
+    while (position < target.size()) {
+        std::size_t best_length{position < source.size() ? MatchLength(source, position, target, position) : 0};
+        BpsAction best_action{SourceRead};
+        std::size_t best_offset{position};
+
+        if (position < target_hashes.size()) {
+            std::uint32_t const hash{target_hashes[position]};
+
+            source_index.ForEachCandidate(hash, [&](std::size_t candidate) {
+                if (std::size_t const length{MatchLength(source, candidate, target, position)}; length > best_length + 2) {
+                    best_length = length;
+                    best_action = SourceCopy;
+                    best_offset = candidate;
+                }
+            });
+
+            target_index.ForEachCandidate(hash, [&](std::size_t candidate) {
+                if (std::size_t const length{MatchLength(target, candidate, target, position)}; length > best_length + 2) {
+                    best_length = length;
+                    best_action = TargetCopy;
+                    best_offset = candidate;
+                }
+            });
+        }
+
+        // Copies cost a length and an offset, shorter matches are cheaper as literals.
+        std::size_t const minimum_length{best_action == SourceRead ? 1u : 4u};
+        if (best_length < minimum_length) {
+            index_target_until(++position);
+            continue;
+        }
+
+        encoder.Literal(target, literal_start, position);
+        if (best_action == SourceRead)
+            encoder.Read(best_length);
+        else
+            encoder.Copy(best_action, best_offset, best_length);
+
+        position += best_length;
+        literal_start = position;
+        index_target_until(position);
+    }
+
+    encoder.Literal(target, literal_start, target.size());
+
+    PutLittleEndian32(patch, Crc32(source));
+    PutLittleEndian32(patch, Crc32(target));
+    PutLittleEndian32(patch, Crc32(patch));
+
+    return patch;
+}
+
+std::optional<std::string> CreatePatch(PatchFormat format, std::string_view source, std::string_view target) {
+    switch (format) {
+        case PatchFormat::Ips:
+            return CreateIpsPatch(source, target);
+        case PatchFormat::Bps:
+            return CreateBpsPatch(source, target);
+        case PatchFormat::None:
+            break;
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::string> ApplyIpsPatch(std::string_view source, std::string_view patch) {
+    if (!patch.starts_with(c_IpsHeader))
+        return std::nullopt;
+
+    std::string target{source};
+    std::size_t offset{c_IpsHeader.size()};
+
+    while (true) {
+        if (offset + 3 > patch.size())
+            return std::nullopt;
+
+        if (patch.substr(offset, 3) == c_IpsFooter) {
+            offset += 3;
+            break;
+        }
+
+        std::size_t const record_offset{GetBigEndian(patch, offset, 3)};
+        if (offset + 5 > patch.size())
+            return std::nullopt;
+
+        std::size_t const size{GetBigEndian(patch, offset + 3, 2)};
+        offset += 5;
+
+        if (size != 0) {
+            if (offset + size > patch.size())
+                return std::nullopt;
+
+            if (target.size() < record_offset + size)
+                target.resize(record_offset + size);
+            target.replace(record_offset, size, patch.substr(offset, size));
+            offset += size;
+            continue;
+        }
+
+        if (offset + 3 > patch.size())
+            return std::nullopt;
+
+        std::size_t const run_size{GetBigEndian(patch, offset, 2)};
+        char const value{patch[offset + 2]};
+        offset += 3;
+
+        if (target.size() < record_offset + run_size)
+            target.resize(record_offset + run_size);
+        std::fill_n(target.begin() + static_cast<std::ptrdiff_t>(record_offset), run_size, value);
+    }
+
+    if (offset + 3 == patch.size())
+        target.resize(GetBigEndian(patch, offset, 3));
+    else if (offset != patch.size())
+        return std::nullopt;
+
+    return target;
+}
+
+std::optional<std::string> ApplyBpsPatch(std::string_view source, std::string_view patch) {
+    if (!patch.starts_with(c_BpsHeader) || patch.size() < c_BpsHeader.size() + c_BpsFooterSize)
+        return std::nullopt;
+
+    std::string_view const footer{patch.substr(patch.size() - c_BpsFooterSize)};
+    auto const footer_crc{[&](std::size_t index) {
+        return static_cast<std::uint32_t>(Byte(footer, index * 4) | Byte(footer, index * 4 + 1) << 8 | Byte(footer, index * 4 + 2) << 16 |
+                                          static_cast<std::uint32_t>(Byte(footer, index * 4 + 3)) << 24);
+    }};
+
+    if (Crc32(patch.substr(0, patch.size() - 4)) != footer_crc(2) || Crc32(source) != footer_crc(0))
+        return std::nullopt;
+
+    std::string_view const actions{patch.substr(0, patch.size() - c_BpsFooterSize)};
+    std::size_t offset{c_BpsHeader.size()};
+    std::uint64_t source_size, target_size, metadata_size;
+    if (!GetNumber(actions, offset, source_size) || !GetNumber(actions, offset, target_size) || !GetNumber(actions, offset, metadata_size))
+        return std::nullopt;
+
+    if (source_size != source.size() || metadata_size > actions.size() - offset)
+        return std::nullopt;
+    offset += metadata_size;
+
+    std::string target;
+    target.reserve(target_size);
+    std::int64_t source_relative_offset{0};
+    std::int64_t target_relative_offset{0};
+
+    while (offset < actions.size()) {
+        std::uint64_t command;
+        if (!GetNumber(actions, offset, command))
+            return std::nullopt;
+
+        std::uint64_t const length{(command >> 2) + 1};
+        if (target.size() + length > target_size)
+            return std::nullopt;
+
+        switch (static_cast<BpsAction>(command & 3)) {
+            case SourceRead:
+                if (target.size() + length > source.size())
+                    return std::nullopt;
+                target.append(source.substr(target.size(), length));
+                break;
+
+            case TargetRead:
+                if (offset + length > actions.size())
+                    return std::nullopt;
+                target.append(actions.substr(offset, length));
+                offset += length;
+                break;
+
+            case SourceCopy:
+            case TargetCopy: {
+                std::uint64_t encoded_delta;
+                if (!GetNumber(actions, offset, encoded_delta))
+                    return std::nullopt;
+
+                auto const delta{static_cast<std::int64_t>(encoded_delta >> 1) * ((encoded_delta & 1) ? -1 : 1)};
+                bool const from_source{(command & 3) == SourceCopy};
+                auto &relative_offset{from_source ? source_relative_offset : target_relative_offset};
+                relative_offset += delta;
+
+                // Target copies may overlap what they produce, so they are done byte by byte.
+                for (std::uint64_t i{0}; i < length; ++i, ++relative_offset) {
+                    std::string_view const from{from_source ? source : std::string_view{target}};
+                    if (relative_offset < 0 || static_cast<std::uint64_t>(relative_offset) >= from.size())
+                        return std::nullopt;
+                    target.push_back(from[static_cast<std::size_t>(relative_offset)]);
+                }
+                break;
+            }
+        }
+    }
+
+    if (target.size() != target_size || Crc32(target) != footer_crc(1))
+        return std::nullopt;
+
+    return target;
+}
+
+std::optional<std::string> ApplyPatch(PatchFormat format, std::string_view source, std::string_view patch) {
+    switch (format) {
+        case PatchFormat::Ips:
+            return ApplyIpsPatch(source, patch);
+        case PatchFormat::Bps:
+            return ApplyBpsPatch(source, patch);
+        case PatchFormat::None:
+            break;
+    }
+
+    return std::nullopt;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+enum class PatchFormat {
+    None,
+    Ips,
+    Bps
+};
+
+[[nodiscard]]
+std::string_view PatchExtension(PatchFormat format) noexcept;
+
+// IPS can only address the first 16 MiB and has no way to express moved data, it is only worth it for
+// in-place edits. Fails for targets IPS cannot address.
+[[nodiscard]]
+std::optional<std::string> CreateIpsPatch(std::string_view source, std::string_view target);
+
+// BPS patches use source and target copies found with a rolling hash, so edits that shift the rest of the ROM
+// stay small too.
+[[nodiscard]]
+std::string CreateBpsPatch(std::string_view source, std::string_view target);
+
+[[nodiscard]]
+std::optional<std::string> CreatePatch(PatchFormat format, std::string_view source, std::string_view target);
+
+[[nodiscard]]
+std::optional<std::string> ApplyIpsPatch(std::string_view source, std::string_view patch);
+
+// Checks the source, target and patch checksums, any mismatch fails.
+[[nodiscard]]
+std::optional<std::string> ApplyBpsPatch(std::string_view source, std::string_view patch);
+
+[[nodiscard]]
+std::optional<std::string> ApplyPatch(PatchFormat format, std::string_view source, std::string_view patch);
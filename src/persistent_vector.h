@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+// A vector whose copies share storage. Elements live in small leaves behind shared pointers, copying the vector only
+// copies the list of leaves and a change copies the one leaf it touches, unless no other copy shares that leaf.
+// Finding an index walks the leaf sizes, so access is O(n / LeafCapacity) with a small constant. Block inserts and
+// moves work on whole leaves, cutting at most a leaf at each end of the block.
+template<typename T, std::size_t LeafCapacity = 64>
+class PersistentVector final {
+public:
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    [[nodiscard]]
+    T const &operator[](std::size_t index) const {
+        auto const [leaf, offset]{Locate(index)};
+        return leaves_[leaf]->items[offset];
+    }
+
+    void Set(std::size_t index, T value) {
+        auto const [leaf, offset]{Locate(index)};
+        Mutable(leaf).items[offset] = std::move(value);
+    }
+
+    void Insert(std::size_t index, T value) {
+        assert(index <= size_);
+
+        if (leaves_.empty())
+            leaves_.push_back(std::make_shared<Leaf>());
+
+        auto const [leaf, offset]{index == size_ ? std::pair{leaves_.size() - 1, leaves_.back()->items.size()} : Locate(index)};
+        auto &items{Mutable(leaf).items};
+        items.insert(items.begin() + static_cast<std::ptrdiff_t>(offset), std::move(value));
+        ++size_;
+
+        if (items.size() > LeafCapacity) {
+            auto split{std::make_shared<Leaf>()};
+            split->items.assign(std::make_move_iterator(items.begin() + LeafCapacity / 2), std::make_move_iterator(items.end()));
+            items.resize(LeafCapacity / 2);
+            leaves_.insert(leaves_.begin() + static_cast<std::ptrdiff_t>(leaf) + 1, std::move(split));
+        }
+    }
+
+    // Inserts every element of `values` in order at `index`, packed into new leaves.
+    template<typename Range>
+    void InsertRange(std::size_t index, Range &&values) {
+        assert(index <= size_);
+
+        std::vector<std::shared_ptr<Leaf>> inserted;
+        std::size_t added{0};
+        for (auto &&value : values) {
+            if (inserted.empty() || inserted.back()->items.size() == LeafCapacity) {
+                inserted.push_back(std::make_shared<Leaf>());
+                inserted.back()->items.reserve(LeafCapacity);
+            }
+            inserted.back()->items.push_back(std::forward<decltype(value)>(value));
+            ++added;
+        }
+
+        auto const leaf{Cut(index)};
+        leaves_.insert(leaves_.begin() + static_cast<std::ptrdiff_t>(leaf), std::make_move_iterator(inserted.begin()),
+                       std::make_move_iterator(inserted.end()));
+        size_ += added;
+        MergeAt(leaf + inserted.size());
+        MergeAt(leaf);
+    }
+
+    // Moves the block of `count` elements at `from` so that it starts at `to`, shifting the elements in between. Only
+    // leaf pointers are rotated, so the cost is the leaves moved over rather than the elements.
+    void Move(std::size_t from, std::size_t to, std::size_t count) {
+        assert(from + count <= size_ && to + count <= size_);
+        if (from == to || count == 0)
+            return;
+
+        auto const [first, middle, last]{to < from ? std::tuple{to, from, from + count} : std::tuple{from, from + count, to + count}};
+        // Cut front to back, a cut only shifts the leaves after it.
+        auto const first_leaf{Cut(first)};
+        auto const middle_leaf{Cut(middle)};
+        auto const last_leaf{Cut(last)};
+        auto const at{[this](std::size_t leaf) {
+            return leaves_.begin() + static_cast<std::ptrdiff_t>(leaf);
+        }};
+        std::rotate(at(first_leaf), at(middle_leaf), at(last_leaf));
+
+        // Merged back to front, a merge only shifts the leaves after it.
+        MergeAt(last_leaf);
+        MergeAt(first_leaf + (last_leaf - middle_leaf));
+        MergeAt(first_leaf);
+    }
+
+    void PushBack(T value) {
+        Insert(size_, std::move(value));
+    }
+
+    void Erase(std::size_t index) {
+        auto const [leaf, offset]{Locate(index)};
+        auto &items{Mutable(leaf).items};
+        items.erase(items.begin() + static_cast<std::ptrdiff_t>(offset));
+        --size_;
+
+        if (items.empty())
+            leaves_.erase(leaves_.begin() + static_cast<std::ptrdiff_t>(leaf));
+    }
+
+    void Clear() noexcept {
+        leaves_.clear();
+        size_ = 0;
+    }
+
+    // Whether this is a copy of `other` and neither has changed since. A change always clones the leaf it touches while
+    // a copy shares it, so comparing the leaf pointers is enough.
+    [[nodiscard]]
+    bool SameAs(PersistentVector const &other) const noexcept {
+        return size_ == other.size_ && leaves_ == other.leaves_;
+    }
+
+    // Visits every element in order, without the per-index leaf walk.
+    template<typename Function>
+    void ForEach(Function function) const {
+        std::size_t index{0};
+        for (auto const &leaf : leaves_) {
+            for (auto const &item : leaf->items)
+                function(index++, item);
+        }
+    }
+
+    // Visits the `count` elements from `first` on, in order.
+    template<typename Function>
+    void ForEach(std::size_t first, std::size_t count, Function function) const {
+        if (count == 0)
+            return;
+
+        auto [leaf, offset]{Locate(first)};
+        for (std::size_t index{first}; index < first + count; ++index) {
+            function(index, leaves_[leaf]->items[offset]);
+            if (++offset == leaves_[leaf]->items.size()) {
+                ++leaf;
+                offset = 0;
+            }
+        }
+    }
+
+    // Visits every element that differs from the one at the same index in `other`, which must be as long. Leaves the
+    // two still share at the same position are skipped whole, so comparing a copy with its original costs the leaves
+    // changed since.
+    template<typename Function>
+    void ForEachDifference(PersistentVector const &other, Function function) const {
+        assert(size_ == other.size_);
+
+        std::size_t leaf{0}, offset{0};
+        std::size_t other_leaf{0}, other_offset{0};
+        for (std::size_t index{0}; index < size_;) {
+            if (offset == 0 && other_offset == 0 && leaves_[leaf] == other.leaves_[other_leaf]) {
+                index += leaves_[leaf]->items.size();
+                ++leaf;
+                ++other_leaf;
+                continue;
+            }
+
+            if (auto const &item{leaves_[leaf]->items[offset]}; !(item == other.leaves_[other_leaf]->items[other_offset]))
+                function(index, item);
+
+            ++index;
+            if (++offset == leaves_[leaf]->items.size()) {
+                ++leaf;
+                offset = 0;
+            }
+            if (++other_offset == other.leaves_[other_leaf]->items.size()) {
+                ++other_leaf;
+                other_offset = 0;
+            }
+        }
+    }
+
+private:
+    struct Leaf final {
+        std::vector<T> items;
+    };
+
+    std::vector<std::shared_ptr<Leaf>> leaves_;
+    std::size_t size_{0};
+
+    [[nodiscard]]
+    std::pair<std::size_t, std::size_t> Locate(std::size_t index) const {
+        assert(index < size_);
+
+        std::size_t leaf{0};
+        while (index >= leaves_[leaf]->items.size()) {
+            index -= leaves_[leaf]->items.size();
+            ++leaf;
+        }
+
+        return {leaf, index};
+    }
+
+    // Splits the leaf holding `index` so that a leaf starts there and returns that leaf, or the leaf count at the end.
+    std::size_t Cut(std::size_t index) {
+        if (index == size_)
+            return leaves_.size();
+
+        auto const [leaf, offset]{Locate(index)};
+        if (offset == 0)
+            return leaf;
+
+        auto &items{Mutable(leaf).items};
+        auto split{std::make_shared<Leaf>()};
+        split->items.assign(std::make_move_iterator(items.begin() + static_cast<std::ptrdiff_t>(offset)),
+                            std::make_move_iterator(items.end()));
+        items.erase(items.begin() + static_cast<std::ptrdiff_t>(offset), items.end());
+        leaves_.insert(leaves_.begin() + static_cast<std::ptrdiff_t>(leaf) + 1, std::move(split));
+        return leaf + 1;
+    }
+
+    // Joins the leaves either side of a cut back into one if they fit, so repeated cuts do not leave a trail of tiny
+    // leaves behind.
+    void MergeAt(std::size_t leaf) {
+        if (leaf == 0 || leaf >= leaves_.size() || leaves_[leaf - 1]->items.size() + leaves_[leaf]->items.size() > LeafCapacity)
+            return;
+
+        auto const next{std::move(leaves_[leaf])};
+        leaves_.erase(leaves_.begin() + static_cast<std::ptrdiff_t>(leaf));
+        auto &items{Mutable(leaf - 1).items};
+        items.insert(items.end(), next->items.begin(), next->items.end());
+    }
+
+    // Leaves shared with another copy are cloned before being written to.
+    [[nodiscard]]
+    Leaf &Mutable(std::size_t leaf) {
+        auto &pointer{leaves_[leaf]};
+        if (pointer.use_count() != 1)
+            pointer = std::make_shared<Leaf>(*pointer);
+
+        return *pointer;
+    }
+};
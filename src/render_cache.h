@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include <ftxui/dom/elements.hpp>
+
+// Keeps an element between frames and rebuilds it only when the state it was built from, the key, changes. FTXUI lays
+// out and draws every element anew each frame, so a reused element still reflects boxes and takes focus as usual.
+template<typename Key>
+class CachedElement final {
+public:
+    template<typename Build>
+    [[nodiscard]]
+    ftxui::Element Get(Key const &key, Build &&build) {
+        if (!element_ || !(key == key_)) {
+            key_ = key;
+            element_ = std::forward<Build>(build)();
+            ++rebuilds_;
+        }
+
+        return element_;
+    }
+
+    void Invalidate() noexcept {
+        element_ = nullptr;
+    }
+
+    [[nodiscard]]
+    std::size_t Rebuilds() const noexcept {
+        return rebuilds_;
+    }
+
+private:
+    Key key_{};
+    ftxui::Element element_;
+    std::size_t rebuilds_{0};
+};
@@ -0,0 +1,193 @@
+#include "replace.h"
+
+#include <algorithm>
+#include <array>
+#include <future>
+#include <iterator>
+#include <regex>
+#include <string_view>
+
+#include "deck.h"
+#include "export.h"
+#include "hash.h"
+#include "thread_pool.h"
+
+namespace {
+    // Fewer slides than this are not worth a task of their own.
+    constexpr std::size_t c_MinChunkSize{64};
+
+    // Replaces every match in a row, returning the number of matches. Read-only once built, so every task shares one.
+    class RowReplacer final {
+    public:
+        explicit RowReplacer(ReplaceOptions const &options)
+            : options_{options} {
+            if (options.regex) {
+                auto flags{std::regex::ECMAScript};
+                if (!options.match_case)
+                    flags |= std::regex::icase;
+                regex_.emplace(options.find, flags);
+            }
+        }
+
+        std::size_t Replace(std::string_view row, std::string &out) const {
+            out.clear();
+            return regex_ ? ReplaceRegex(row, out) : ReplaceText(row, out);
+        }
+
+    private:
+        ReplaceOptions const &options_;
+        std::optional<std::regex> regex_;
+
+        std::size_t ReplaceText(std::string_view row, std::string &out) const {
+            auto const equal{[this](char a, char b) {
+                return options_.match_case ? a == b : FoldGlyph(a) == FoldGlyph(b);
+            }};
+
+            std::size_t matches{0};
+            auto from{row.begin()};
+            while (true) {
+                auto const match{std::search(from, row.end(), options_.find.begin(), options_.find.end(), equal)};
+                out.append(from, match);
+                if (match == row.end())
+                    return matches;
+
+                out += options_.replacement;
+                from = match + static_cast<std::ptrdiff_t>(options_.find.size());
+                ++matches;
+            }
+        }
+
+        std::size_t ReplaceRegex(std::string_view row, std::string &out) const {
+            using Iterator = std::regex_iterator<std::string_view::const_iterator>;
+
+            std::size_t matches{0};
+            auto last{row.begin()};
+            for (Iterator it{row.begin(), row.end(), *regex_}, end; it != end; ++it) {
+                auto const &match{*it};
+                out.append(last, match[0].first);
+                out += match.format(options_.replacement);
+                last = match[0].second;
+                ++matches;
+            }
+            out.append(last, row.end());
+            return matches;
+        }
+    };
+
+    // Lays the rows out on a blank slide as typing them would, rows longer than c_MaxColumns wrapping onto the next.
+    // Returns false if they do not fit.
+    [[nodiscard]]
+    bool LayOutRows(SlideGrid const &original, std::span<std::string const> rows, SlideGrid &result) noexcept {
+        result = SlideGrid{};
+        result.row_count = 0;
+
+        for (std::size_t row{0}; row < rows.size(); ++row) {
+            std::string_view const text{rows[row]};
+            std::size_t offset{0};
+            do {
+                if (result.row_count == c_MaxRows)
+                    return false;
+
+                auto const chunk{text.substr(offset, c_MaxColumns)};
+                int const out{result.row_count++};
+                result.SetBigText(out, original.IsBigText(static_cast<int>(row)));
+                std::ranges::copy(chunk, result.glyphs[out].begin());
+                result.row_lengths[out] = static_cast<std::uint8_t>(chunk.size());
+                offset += c_MaxColumns;
+            } while (offset < text.size());
+        }
+
+        return true;
+    }
+
+    [[nodiscard]]
+    std::optional<SlideReplacement> ReplaceSlide(RowReplacer const &replacer, std::size_t index, SlideGrid const &slide) {
+        std::array<std::string, c_MaxRows> rows;
+        SlideReplacement replacement;
+
+        for (int row{0}; row < slide.row_count; ++row) {
+            auto &after{rows[static_cast<std::size_t>(row)]};
+            auto const before{slide.Row(row)};
+            auto const matches{replacer.Replace(before, after)};
+            if (matches == 0)
+                continue;
+
+            replacement.matches += matches;
+            if (after != before) {
+                replacement.wraps |= after.size() > c_MaxColumns;
+                replacement.bad_glyphs |= !std::ranges::all_of(after, IsSlideGlyph);
+                replacement.rows.push_back({row, std::string{before}, after});
+            }
+        }
+
+        if (replacement.rows.empty())
+            return std::nullopt;
+
+        replacement.slide = index;
+        replacement.hash = HashBytes(slide.Bytes());
+        bool const fits{LayOutRows(slide, std::span{rows}.first(slide.row_count), replacement.result)};
+        replacement.overflows = !fits || (ScreenRowCount(replacement.result) > c_MaxSlideLines && ScreenRowCount(slide) <= c_MaxSlideLines);
+        return replacement;
+    }
+}
+
+std::optional<std::vector<SlideReplacement>> PlanReplace(Deck const &deck, ReplaceOptions const &options, ThreadPool &pool) {
+    if (options.find.empty())
+        return std::vector<SlideReplacement>{};
+
+    std::optional<RowReplacer> replacer;
+    try {
+        replacer.emplace(options);
+    } catch (std::regex_error const &) {
+        return std::nullopt;
+    }
+
+    // The caller waits for the scan, nothing edits the deck meanwhile.
+    std::size_t const count{deck.Size()};
+    std::size_t const chunk_size{std::max(c_MinChunkSize, (count + pool.ThreadCount() - 1) / pool.ThreadCount())};
+
+    std::vector<std::future<std::vector<SlideReplacement>>> pending;
+    for (std::size_t first{0}; first < count; first += chunk_size) {
+        pending.push_back(pool.Submit([&deck, &replacer, first, last = std::min(first + chunk_size, count)] {
+            std::vector<SlideReplacement> found;
+            for (std::size_t i{first}; i < last; ++i) {
+                if (auto replacement{ReplaceSlide(*replacer, i, deck[i])})
+                    found.push_back(std::move(*replacement));
+            }
+            return found;
+        }));
+    }
+
+    // A regex too complex to match throws on the task, every task is still waited for before giving up.
+    std::vector<SlideReplacement> replacements;
+    bool failed{false};
+    for (auto &future : pending) {
+        try {
+            auto found{future.get()};
+            std::ranges::move(found, std::back_inserter(replacements));
+        } catch (std::regex_error const &) {
+            failed = true;
+        }
+    }
+
+    if (failed)
+        return std::nullopt;
+    return replacements;
+}
+
+std::size_t ApplyReplace(Deck &deck, std::span<SlideReplacement const> replacements) {
+    std::size_t applied{0};
+    for (auto const &replacement : replacements) {
+        if (!replacement.Applicable() || replacement.slide >= deck.Size())
+            continue;
+
+        auto &slide{deck.Storage().slides[replacement.slide]};
+        if (HashBytes(slide.Bytes()) != replacement.hash)
+            continue;
+
+        slide = replacement.result;
+        deck.Edited(replacement.slide);
+        ++applied;
+    }
+    return applied;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "slides.h"
+
+class Deck;
+class ThreadPool;
+
+struct ReplaceOptions final {
+    std::string find;
+    // With `regex`, may refer to groups as $1, $2...
+    std::string replacement;
+    bool regex{false};
+    bool match_case{false};
+
+    bool operator==(ReplaceOptions const &) const = default;
+};
+
+struct RowReplacement final {
+    int row{};
+    std::string before;
+    // May be longer than c_MaxColumns, the slide wraps it onto the rows below.
+    std::string after;
+};
+
+struct SlideReplacement final {
+    std::size_t slide{};
+    // Of the slide as it was scanned, a slide edited since is left alone.
+    std::uint64_t hash{};
+    SlideGrid result;
+    std::vector<RowReplacement> rows;
+    std::size_t matches{};
+    // A row grew past c_MaxColumns and wraps.
+    bool wraps{false};
+    // The slide would no longer fit in c_MaxRows, or would run into the row the NES screen keeps free. Never applied.
+    bool overflows{false};
+    // The replacement holds characters a slide cannot, see IsSlideGlyph. Never applied.
+    bool bad_glyphs{false};
+
+    [[nodiscard]]
+    bool Applicable() const noexcept {
+        return !overflows && !bad_glyphs;
+    }
+};
+
+// Scans the deck on the pool, in chunks of consecutive slides, and returns every slide that changes in deck order.
+// Matches never span rows. Returns nullopt if the pattern is not a valid regex.
+[[nodiscard]]
+std::optional<std::vector<SlideReplacement>> PlanReplace(Deck const &deck, ReplaceOptions const &options, ThreadPool &pool);
+
+// Applies the replacements that are applicable, to the slides still as they were scanned. Returns the number of slides
+// changed.
+std::size_t ApplyReplace(Deck &deck, std::span<SlideReplacement const> replacements);
@@ -0,0 +1,185 @@
+#include "replace_panel.h"
+
+#include <algorithm>
+#include <format>
+#include <string>
+
+#include <ftxui/component/component.hpp>
+#include <ftxui/component/mouse.hpp>
+#include <ftxui/dom/elements.hpp>
+
+#include "deck.h"
+
+namespace {
+    constexpr int c_DiffRows{16};
+    constexpr int c_ReplaceWidth{c_MaxColumns * 2 + 8};
+}
+
+ReplacePanel::ReplacePanel(Deck const &deck, ThreadPool &pool, std::function<void(std::span<SlideReplacement const>)> on_apply,
+                           std::function<void()> on_close)
+    : deck_{deck}
+    , pool_{pool}
+    , on_apply_{std::move(on_apply)}
+    , on_close_{std::move(on_close)} {
+    using namespace ftxui;
+
+    InputOption input_option;
+    input_option.multiline = false;
+    input_option.on_enter = [this] { Preview(); };
+
+    find_input_ = Input(&options_.find, "text or pattern", input_option);
+    replacement_input_ = Input(&options_.replacement, "replacement", input_option);
+    regex_checkbox_ = Checkbox("Regex", &options_.regex);
+    case_checkbox_ = Checkbox("Match case", &options_.match_case);
+    preview_button_ = Button("Preview", [this] { Preview(); }, ButtonOption::Ascii());
+    apply_button_ = Button("Replace All", [this] { Apply(); }, ButtonOption::Ascii());
+    close_button_ = Button("Close", [this] {
+        if (on_close_)
+            on_close_();
+    }, ButtonOption::Ascii());
+
+    Add(Container::Vertical({
+        find_input_,
+        replacement_input_,
+        Container::Horizontal({regex_checkbox_, case_checkbox_}),
+        Container::Horizontal({preview_button_, apply_button_, close_button_})
+    }));
+}
+
+void ReplacePanel::Preview() {
+    using Clock = std::chrono::steady_clock;
+
+    auto const start{Clock::now()};
+    auto replacements{PlanReplace(deck_, options_, pool_)};
+    scan_time_ = Clock::now() - start;
+
+    previewed_ = options_;
+    invalid_ = !replacements;
+    replacements_ = replacements ? std::move(*replacements) : std::vector<SlideReplacement>{};
+    top_ = 0;
+
+    lines_.clear();
+    for (std::size_t i{0}; i < replacements_.size(); ++i) {
+        lines_.push_back({i, -1, false});
+        for (std::size_t row{0}; row < replacements_[i].rows.size(); ++row) {
+            lines_.push_back({i, static_cast<int>(row), false});
+            lines_.push_back({i, static_cast<int>(row), true});
+        }
+    }
+}
+
+void ReplacePanel::Apply() {
+    // What is applied is always what is shown.
+    if (previewed_ != options_) {
+        Preview();
+        return;
+    }
+
+    if (!replacements_.empty() && on_apply_)
+        on_apply_(replacements_);
+
+    replacements_.clear();
+    lines_.clear();
+    previewed_.reset();
+}
+
+void ReplacePanel::Scroll(int lines) {
+    top_ = std::clamp(top_ + lines, 0, std::max(static_cast<int>(lines_.size()) - c_DiffRows, 0));
+}
+
+ftxui::Element ReplacePanel::RenderLine(DiffLine const &line) const {
+    using namespace ftxui;
+
+    auto const &replacement{replacements_[line.replacement]};
+    if (line.row < 0) {
+        return hbox({
+            text(std::format("{}: {} matches", Deck::Title(replacement.slide), replacement.matches)) | bold,
+            replacement.bad_glyphs
+                ? text(" - characters a slide cannot hold, skipped") | color(Color::Red)
+                : replacement.overflows
+                ? text(" - does not fit, skipped") | color(Color::Red)
+                : replacement.wraps ? text(" - wraps") | color(Color::Yellow) : emptyElement()
+        });
+    }
+
+    auto const &row{replacement.rows[static_cast<std::size_t>(line.row)]};
+    if (!line.after)
+        return text(std::format("  {:>2} - {}", row.row, row.before)) | color(Color::Red);
+
+    // What runs past the edge of the slide wraps onto the rows below.
+    std::string_view const after{row.after};
+    return hbox({
+        text(std::format("     + {}", after.substr(0, c_MaxColumns))) | color(Color::Green),
+        text(std::string{after.substr(std::min<std::size_t>(after.size(), c_MaxColumns))}) | color(Color::Yellow)
+    });
+}
+
+ftxui::Element ReplacePanel::RenderSummary() const {
+    using namespace ftxui;
+
+    if (!previewed_)
+        return text("Preview to see the changes") | dim;
+    if (invalid_)
+        return text("Not a valid regex") | color(Color::Red);
+
+    std::size_t matches{0};
+    std::size_t skipped{0};
+    for (auto const &replacement : replacements_) {
+        matches += replacement.matches;
+        skipped += replacement.Applicable() ? 0 : 1;
+    }
+
+    auto summary{std::format("{} matches on {} slides, scanned in {} us", matches, replacements_.size(),
+                             std::chrono::duration_cast<std::chrono::microseconds>(scan_time_).count())};
+    if (skipped > 0)
+        summary += std::format(", {} slides skipped", skipped);
+    if (previewed_ != options_)
+        summary += " - out of date";
+
+    return text(summary) | (skipped > 0 ? color(Color::Red) : dim);
+}
+
+ftxui::Element ReplacePanel::Render() {
+    using namespace ftxui;
+
+    int const last{std::min(top_ + c_DiffRows, static_cast<int>(lines_.size()))};
+
+    Elements diff;
+    for (int i{top_}; i < last; ++i)
+        diff.push_back(RenderLine(lines_[static_cast<std::size_t>(i)]));
+
+    return window(text("Replace"), vbox({
+        hbox({text("Find:    "), find_input_->Render() | flex}),
+        hbox({text("Replace: "), replacement_input_->Render() | flex}),
+        hbox({regex_checkbox_->Render(), text("  "), case_checkbox_->Render()}),
+        hbox({preview_button_->Render(), text(" "), apply_button_->Render(), text(" "), close_button_->Render()}),
+        separator(),
+        vbox(std::move(diff)) | reflect(diff_box_) | size(HEIGHT, EQUAL, c_DiffRows),
+        separator(),
+        RenderSummary()
+    })) | size(WIDTH, EQUAL, c_ReplaceWidth);
+}
+
+bool ReplacePanel::OnEvent(ftxui::Event event) {
+    using ftxui::Event;
+    using ftxui::Mouse;
+
+    if (event == Event::Escape) {
+        if (on_close_)
+            on_close_();
+        return true;
+    }
+
+    if (event == Event::PageUp || event == Event::PageDown) {
+        Scroll(event == Event::PageUp ? -c_DiffRows : c_DiffRows);
+        return true;
+    }
+
+    if (event.is_mouse() && diff_box_.Contain(event.mouse().x, event.mouse().y)
+        && (event.mouse().button == Mouse::WheelUp || event.mouse().button == Mouse::WheelDown)) {
+        Scroll(event.mouse().button == Mouse::WheelUp ? -1 : 1);
+        return true;
+    }
+
+    return ComponentBase::OnEvent(event);
+}
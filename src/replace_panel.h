@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <ftxui/component/component_base.hpp>
+#include <ftxui/component/event.hpp>
+#include <ftxui/screen/box.hpp>
+
+#include "replace.h"
+
+class Deck;
+class ThreadPool;
+
+// Find and replace across the deck. Preview, or Return in either field, scans the deck and lists every row that would
+// change, old and new, marking the slides that would wrap, no longer fit or take characters a slide cannot hold.
+// Replace All hands the previewed replacements to `on_apply`, previewing first if the fields changed since. Escape
+// calls `on_close`.
+class ReplacePanel final : public ftxui::ComponentBase {
+public:
+    ReplacePanel(Deck const &deck, ThreadPool &pool, std::function<void(std::span<SlideReplacement const>)> on_apply,
+                 std::function<void()> on_close);
+
+    ftxui::Element Render() override;
+    bool OnEvent(ftxui::Event event) override;
+
+private:
+    // A line of the preview: a slide's heading, or the old or the new text of one of its rows.
+    struct DiffLine final {
+        std::size_t replacement{};
+        // -1 for the heading.
+        int row{-1};
+        bool after{false};
+    };
+
+    Deck const &deck_;
+    ThreadPool &pool_;
+    std::function<void(std::span<SlideReplacement const>)> on_apply_;
+    std::function<void()> on_close_;
+    ReplaceOptions options_;
+    // What the preview was made with, nullopt before the first.
+    std::optional<ReplaceOptions> previewed_;
+    bool invalid_{false};
+    std::vector<SlideReplacement> replacements_;
+    std::vector<DiffLine> lines_;
+    std::chrono::nanoseconds scan_time_{};
+    // The first preview line in view.
+    int top_{0};
+    ftxui::Box diff_box_;
+
+    ftxui::Component find_input_;
+    ftxui::Component replacement_input_;
+    ftxui::Component regex_checkbox_;
+    ftxui::Component case_checkbox_;
+    ftxui::Component preview_button_;
+    ftxui::Component apply_button_;
+    ftxui::Component close_button_;
+
+    void Preview();
+    void Apply();
+    void Scroll(int lines);
+
+    [[nodiscard]]
+    ftxui::Element RenderLine(DiffLine const &line) const;
+    [[nodiscard]]
+    ftxui::Element RenderSummary() const;
+};
@@ -0,0 +1,285 @@
+#include "rom_check.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "deck_io.h"
+#include "export.h"
+#include "hash.h"
+#include "nes.h"
+#include "thread_pool.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Frames run after boot and after every button press before the picture is hashed.
+    constexpr int c_DefaultSettleFrames{30};
+    constexpr int c_PressFrames{2};
+    constexpr std::size_t c_MaxRomSlides{256};
+    constexpr std::string_view c_RomExtension{".nes"};
+    constexpr std::string_view c_GoldenHeader{
+        "# Written by NESlidesEditor --rom-check --update, one \"<deck> <slide> <picture hash>\" a line.\n"
+        "# Refresh it with `cmake --build <build directory> --target rom_check_golden`.\n"
+    };
+
+    constexpr std::array<std::pair<std::string_view, std::uint8_t>, 8> c_ButtonNames{{
+        {"a", NesButtonA}, {"b", NesButtonB}, {"select", NesButtonSelect}, {"start", NesButtonStart},
+        {"up", NesButtonUp}, {"down", NesButtonDown}, {"left", NesButtonLeft}, {"right", NesButtonRight}
+    }};
+
+    struct RomCase final {
+        std::string name;
+        std::string rom;
+        // 0 for a ROM without its deck.
+        std::size_t slide_count{0};
+    };
+
+    struct RomResult final {
+        bool booted{false};
+        std::vector<std::uint64_t> hashes;
+        std::uint64_t frames{0};
+    };
+
+    // Hashes by "<name> <slide>", the name being the deck's path relative to the golden file.
+    using GoldenHashes = std::map<std::string, std::uint64_t>;
+
+    [[nodiscard]]
+    std::string GoldenKey(std::string_view name, std::size_t slide) {
+        return std::format("{} {}", name, slide);
+    }
+
+    [[nodiscard]]
+    std::uint64_t HashPicture(Nes const &nes) noexcept {
+        auto const &picture{nes.Picture()};
+        return HashBytes({reinterpret_cast<char const *>(picture.data()), picture.size()});
+    }
+
+    [[nodiscard]]
+    RomResult RunRom(RomCase const &rom_case, int settle_frames, std::uint8_t next_button) {
+        RomResult result;
+        auto const nes{std::make_unique<Nes>()};
+        if (!nes->Load(rom_case.rom))
+            return result;
+
+        result.booted = true;
+        auto const run{[&](int frames) {
+            for (int frame{0}; frame < frames; ++frame)
+                nes->RunFrame();
+        }};
+
+        run(settle_frames);
+        result.hashes.push_back(HashPicture(*nes));
+
+        std::size_t const limit{rom_case.slide_count > 0 ? rom_case.slide_count : c_MaxRomSlides};
+        while (result.hashes.size() < limit) {
+            nes->SetButtons(next_button);
+            run(c_PressFrames);
+            nes->SetButtons(0);
+            run(settle_frames);
+
+            std::uint64_t const hash{HashPicture(*nes)};
+            if (rom_case.slide_count == 0 && (hash == result.hashes.back() || hash == result.hashes.front()))
+                break;
+            result.hashes.push_back(hash);
+        }
+
+        result.frames = nes->FrameCount();
+        return result;
+    }
+
+    [[nodiscard]]
+    std::optional<GoldenHashes> ReadGolden(std::filesystem::path const &path) {
+        std::string text;
+        if (!ReadFile(path, text))
+            return std::nullopt;
+
+        GoldenHashes golden;
+        std::string_view rest{text};
+        while (!rest.empty()) {
+            auto const end{rest.find('\n')};
+            std::string_view line{rest.substr(0, end)};
+            rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+
+            auto const separator{line.rfind(' ')};
+            if (line.starts_with('#') || separator == std::string_view::npos)
+                continue;
+
+            std::uint64_t hash{};
+            auto const digits{line.substr(separator + 1)};
+            if (std::from_chars(digits.data(), digits.data() + digits.size(), hash, 16).ec != std::errc{})
+                return std::nullopt;
+            golden.insert_or_assign(std::string{line.substr(0, separator)}, hash);
+        }
+
+        return golden;
+    }
+
+    // Decks of the same name in different directories must not share their hashes.
+    [[nodiscard]]
+    std::string CaseName(std::filesystem::path const &path, std::filesystem::path const &golden_directory) {
+        std::error_code error;
+        auto const relative{std::filesystem::relative(path, golden_directory, error)};
+        return (error || relative.empty() ? path : relative).generic_string();
+    }
+
+    // Exports a deck, or reads a ROM as it is.
+    [[nodiscard]]
+    std::optional<RomCase> PrepareRom(std::filesystem::path const &path, std::filesystem::path const &golden_directory,
+                                      ExportCache &cache) {
+        RomCase rom_case{CaseName(path, golden_directory), {}, 0};
+
+        if (path.extension() == c_RomExtension)
+            return ReadFile(path, rom_case.rom) ? std::optional{std::move(rom_case)} : std::nullopt;
+
+        Slides slides;
+        std::size_t damaged{0};
+        if (!ReadSlidesFile(path, slides, damaged) || slides.empty() || !Export(slides, cache) || !ReadFile(ExportedRomPath(), rom_case.rom))
+            return std::nullopt;
+
+        if (damaged > 0)
+            std::cerr << std::format("{}: {} slides lost text a slide cannot hold\n", rom_case.name, damaged);
+
+        rom_case.slide_count = slides.size();
+        return rom_case;
+    }
+}
+
+int RunRomCheck(std::span<char const *const> arguments) {
+    if (arguments.empty()) {
+        std::cerr << "usage: NESlidesEditor --rom-check <golden file> [--update] [--settle=<frames>] [--next=<button>] <deck, ROM or directory>...\n";
+        return 1;
+    }
+
+    std::filesystem::path const golden_path{arguments.front()};
+    bool update{false};
+    int settle_frames{c_DefaultSettleFrames};
+    std::uint8_t next_button{NesButtonRight};
+    std::vector<std::string_view> inputs;
+
+    for (std::string_view const argument : arguments.subspan(1)) {
+        if (argument == "--update") {
+            update = true;
+        } else if (argument.starts_with("--settle=")) {
+            auto const value{argument.substr(9)};
+            if (std::from_chars(value.data(), value.data() + value.size(), settle_frames).ec != std::errc{} || settle_frames < 1) {
+                std::cerr << std::format("bad frame count {}\n", value);
+                return 1;
+            }
+        } else if (argument.starts_with("--next=")) {
+            auto const name{argument.substr(7)};
+            auto const it{std::ranges::find(c_ButtonNames, name, &std::pair<std::string_view, std::uint8_t>::first)};
+            if (it == c_ButtonNames.end()) {
+                std::cerr << std::format("unknown button {}\n", name);
+                return 1;
+            }
+            next_button = it->second;
+        } else {
+            inputs.emplace_back(argument);
+        }
+    }
+
+    std::vector<std::filesystem::path> const paths{CollectDecks(inputs)};
+    if (paths.empty()) {
+        std::cerr << "no decks or ROMs to check\n";
+        return 1;
+    }
+
+    int failures{0};
+
+    // Exports share the engine's build directory, so they run one after the other. The emulation is independent.
+    ExportCache cache;
+    std::vector<RomCase> cases;
+    auto const golden_directory{std::filesystem::absolute(golden_path).parent_path()};
+    for (auto const &path : paths) {
+        if (auto rom_case{PrepareRom(path, golden_directory, cache)}) {
+            cases.push_back(std::move(*rom_case));
+        } else {
+            std::cerr << std::format("failed to build {}\n", path.string());
+            ++failures;
+        }
+    }
+
+    ThreadPool pool;
+    auto const emulation_start{Clock::now()};
+    std::vector<std::future<RomResult>> pending;
+    pending.reserve(cases.size());
+    for (auto const &rom_case : cases)
+        pending.push_back(pool.Submit([&rom_case, settle_frames, next_button] { return RunRom(rom_case, settle_frames, next_button); }));
+
+    std::vector<RomResult> results;
+    results.reserve(pending.size());
+    std::uint64_t frames{0};
+    for (auto &future : pending)
+        frames += results.emplace_back(future.get()).frames;
+
+    double const seconds{std::chrono::duration<double>(Clock::now() - emulation_start).count()};
+    std::cout << std::format("emulated {} frames of {} ROMs in {:.3f} ms: {:.0f} frames/s\n", frames, cases.size(),
+                             seconds * 1000.0, seconds > 0.0 ? static_cast<double>(frames) / seconds : 0.0);
+
+    for (std::size_t i{0}; i < cases.size(); ++i) {
+        if (!results[i].booted) {
+            std::cerr << std::format("{}: not an NROM image\n", cases[i].name);
+            ++failures;
+        }
+    }
+
+    if (update) {
+        std::string golden{c_GoldenHeader};
+        for (std::size_t i{0}; i < cases.size(); ++i) {
+            for (std::size_t slide{0}; slide < results[i].hashes.size(); ++slide)
+                golden += std::format("{} {:016x}\n", GoldenKey(cases[i].name, slide), results[i].hashes[slide]);
+        }
+
+        if (!WriteFile(golden_path, golden)) {
+            std::cerr << std::format("cannot write {}\n", golden_path.string());
+            return 1;
+        }
+        return failures == 0 ? 0 : 1;
+    }
+
+    auto const golden{ReadGolden(golden_path)};
+    if (!golden) {
+        std::cerr << std::format("cannot read {}\n", golden_path.string());
+        return 1;
+    }
+
+    for (std::size_t i{0}; i < cases.size(); ++i) {
+        auto const &name{cases[i].name};
+        auto const &hashes{results[i].hashes};
+
+        if (!results[i].booted)
+            continue;
+
+        for (std::size_t slide{0}; slide < hashes.size(); ++slide) {
+            auto const it{golden->find(GoldenKey(name, slide))};
+            if (it == golden->end()) {
+                std::cerr << std::format("{} slide {}: no golden hash\n", name, slide);
+                ++failures;
+            } else if (it->second != hashes[slide]) {
+                std::cerr << std::format("{} slide {}: {:016x}, expected {:016x}\n", name, slide, hashes[slide], it->second);
+                ++failures;
+            }
+        }
+
+        if (golden->contains(GoldenKey(name, hashes.size()))) {
+            std::cerr << std::format("{}: {} slides shown, the golden file has more\n", name, hashes.size());
+            ++failures;
+        }
+    }
+
+    std::cout << std::format("{} ROMs checked, {} failures\n", cases.size(), failures);
+    return failures == 0 ? 0 : 1;
+}
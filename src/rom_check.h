@@ -0,0 +1,14 @@
+#pragma once
+
+#include <span>
+
+// Emulator regression check, run as
+//   NESlidesEditor --rom-check <golden file> [--update] [--settle=<frames>] [--next=<button>] <deck, ROM or directory>...
+// Decks are exported first, .nes files are checked as they are. Every ROM is booted in the built-in emulator and
+// stepped through its slides by pressing the next button, right unless given. The picture of each slide is hashed and
+// compared with the golden file, which names decks by their path relative to it and skips lines starting with '#'.
+// --update writes the hashes out as the new golden file instead.
+//
+// A ROM given without its deck is stepped until the picture stops changing or comes back to the first slide.
+[[nodiscard]]
+int RunRomCheck(std::span<char const *const> arguments);
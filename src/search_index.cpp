@@ -0,0 +1,110 @@
+#include "search_index.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include "deck.h"
+
+namespace {
+    [[nodiscard]]
+    bool IsWordGlyph(char glyph) noexcept {
+        return std::isalnum(static_cast<unsigned char>(glyph)) != 0;
+    }
+
+    // Calls `visit(row, column, word)` for every word of the slide, case folded.
+    template<typename Visit>
+    void ForEachWord(SlideGrid const &slide, Visit &&visit) {
+        std::string word;
+        for (int row{0}; row < slide.row_count; ++row) {
+            auto const text{slide.Row(row)};
+            for (std::size_t column{0}; column < text.size();) {
+                if (!IsWordGlyph(text[column])) {
+                    ++column;
+                    continue;
+                }
+
+                auto const start{column};
+                word.clear();
+                for (; column < text.size() && IsWordGlyph(text[column]); ++column)
+                    word.push_back(FoldGlyph(text[column]));
+                visit(row, static_cast<int>(start), word);
+            }
+        }
+    }
+}
+
+void SearchIndex::Assign(Slides const &slides, std::vector<SlideId> const &ids) {
+    postings_.clear();
+    words_.clear();
+    for (std::size_t i{0}; i < slides.size(); ++i)
+        Insert(ids[i], slides[i]);
+}
+
+void SearchIndex::Insert(SlideId id, SlideGrid const &slide) {
+    auto &words{words_[id]};
+    ForEachWord(slide, [&](int row, int column, std::string const &word) {
+        auto &postings{postings_[word]};
+        // A slide's postings are added together, so a word seen before on this slide has the last one.
+        if (postings.empty() || postings.back().slide != id)
+            words.push_back(word);
+        postings.push_back({id, static_cast<std::uint8_t>(row), static_cast<std::uint8_t>(column)});
+    });
+}
+
+void SearchIndex::Erase(SlideId id) {
+    auto const slide{words_.find(id)};
+    if (slide == words_.end())
+        return;
+
+    for (auto const &word : slide->second) {
+        auto const it{postings_.find(word)};
+        std::erase_if(it->second, [id](SearchPosting const &posting) { return posting.slide == id; });
+        if (it->second.empty())
+            postings_.erase(it);
+    }
+    words_.erase(slide);
+}
+
+std::vector<SearchPosting> SearchIndex::Find(std::string_view prefix) const {
+    std::string folded{prefix};
+    std::ranges::transform(folded, folded.begin(), FoldGlyph);
+
+    std::vector<SearchPosting> found;
+    for (auto it{postings_.lower_bound(folded)}; it != postings_.end() && it->first.starts_with(folded); ++it)
+        found.insert(found.end(), it->second.begin(), it->second.end());
+
+    std::ranges::sort(found);
+    return found;
+}
+
+std::vector<SearchMatch> FindInDeck(Deck const &deck, std::string_view text) {
+    std::string folded{text};
+    std::ranges::transform(folded, folded.begin(), FoldGlyph);
+
+    auto const word_start{std::ranges::find_if(folded, IsWordGlyph)};
+    if (word_start == folded.end())
+        return {};
+
+    auto const word_end{std::find_if_not(word_start, folded.end(), IsWordGlyph)};
+    auto const leading{static_cast<int>(word_start - folded.begin())};
+    auto const postings{deck.Index().Find({word_start, word_end})};
+
+    std::vector<SearchMatch> matches;
+    if (postings.empty())
+        return matches;
+
+    for (std::size_t i{0}; i < deck.Size(); ++i) {
+        for (auto const &posting : std::ranges::equal_range(postings, deck.Id(i), {}, &SearchPosting::slide)) {
+            int const column{posting.column - leading};
+            auto const row{deck[i].Row(posting.row)};
+            if (column < 0 || static_cast<std::size_t>(column) + folded.size() > row.size())
+                continue;
+
+            auto const candidate{row.substr(static_cast<std::size_t>(column), folded.size())};
+            if (std::ranges::equal(candidate, folded, {}, FoldGlyph))
+                matches.push_back({i, posting.row, column});
+        }
+    }
+
+    return matches;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "slides.h"
+
+class Deck;
+
+// Where a word starts on a slide.
+struct SearchPosting final {
+    SlideId slide{};
+    std::uint8_t row{};
+    std::uint8_t column{};
+
+    auto operator<=>(SearchPosting const &) const = default;
+};
+
+// An inverted index of the words of every slide, case folded, kept by slide id so that inserting, erasing and moving
+// slides never renumbers it. Editing a slide reindexes only that slide.
+class SearchIndex final {
+public:
+    void Assign(Slides const &slides, std::vector<SlideId> const &ids);
+    void Insert(SlideId id, SlideGrid const &slide);
+    void Erase(SlideId id);
+
+    void Update(SlideId id, SlideGrid const &slide) {
+        Erase(id);
+        Insert(id, slide);
+    }
+
+    // Where every word starting with the prefix is found, by slide id, then row and column.
+    [[nodiscard]]
+    std::vector<SearchPosting> Find(std::string_view prefix) const;
+
+private:
+    std::map<std::string, std::vector<SearchPosting>, std::less<>> postings_;
+    // The distinct words of each slide, to take it out again.
+    std::unordered_map<SlideId, std::vector<std::string>> words_;
+};
+
+struct SearchMatch final {
+    std::size_t slide{};
+    int row{};
+    int column{};
+};
+
+// Every place the text occurs in the deck at the start of a word, ignoring case, in deck order. The index narrows the
+// search to where the first word of the text starts, the slides themselves confirm the rest. Text without a word in it
+// matches nothing.
+[[nodiscard]]
+std::vector<SearchMatch> FindInDeck(Deck const &deck, std::string_view text);
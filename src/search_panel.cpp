@@ -0,0 +1,171 @@
+#include "search_panel.h"
+
+#include <algorithm>
+#include <format>
+
+#include <ftxui/component/mouse.hpp>
+#include <ftxui/dom/elements.hpp>
+
+#include "deck.h"
+
+namespace {
+    constexpr int c_SearchRows{16};
+    constexpr int c_SearchWidth{c_MaxColumns + 18};
+    constexpr int c_LocationWidth{14};
+}
+
+SearchPanel::SearchPanel(Deck const &deck, std::function<void(SearchMatch const &)> on_jump, std::function<void()> on_close)
+    : deck_{deck}
+    , on_jump_{std::move(on_jump)}
+    , on_close_{std::move(on_close)} {
+}
+
+void SearchPanel::Refresh() {
+    using Clock = std::chrono::steady_clock;
+
+    auto const start{Clock::now()};
+    matches_ = FindInDeck(deck_, query_);
+    searched_ = deck_.Snapshot();
+    search_time_ = Clock::now() - start;
+    selected_ = std::clamp(selected_, 0, std::max(static_cast<int>(matches_.size()) - 1, 0));
+}
+
+int SearchPanel::PageSize() const noexcept {
+    int const height{box_.y_max - box_.y_min + 1};
+    return height > 1 ? height : c_SearchRows;
+}
+
+void SearchPanel::Select(int index) {
+    selected_ = std::clamp(index, 0, std::max(static_cast<int>(matches_.size()) - 1, 0));
+}
+
+void SearchPanel::Jump() {
+    if (!matches_.empty() && on_jump_)
+        on_jump_(matches_[static_cast<std::size_t>(selected_)]);
+}
+
+ftxui::Element SearchPanel::Render() {
+    using namespace ftxui;
+
+    if (!searched_.SameAs(deck_.Snapshot()))
+        Refresh();
+
+    int const count{static_cast<int>(matches_.size())};
+    int const page{PageSize()};
+    if (selected_ < top_)
+        top_ = selected_;
+    else if (selected_ >= top_ + page)
+        top_ = selected_ - page + 1;
+    top_ = std::clamp(top_, 0, std::max(count - page, 0));
+
+    int const last{std::min(top_ + page, count)};
+    row_boxes_.resize(static_cast<std::size_t>(last - top_));
+
+    Elements rows;
+    bool const focused{Focused()};
+    for (int index{top_}; index < last; ++index) {
+        auto const &match{matches_[static_cast<std::size_t>(index)]};
+        auto const text_row{deck_[match.slide].Row(match.row)};
+        auto const column{static_cast<std::size_t>(match.column)};
+        auto const length{std::min(query_.size(), text_row.size() - column)};
+
+        auto row{hbox({
+            text(std::format("{}:{}", Deck::Title(match.slide), match.row)) | dim | size(WIDTH, EQUAL, c_LocationWidth),
+            text(std::string{text_row.substr(0, column)}),
+            text(std::string{text_row.substr(column, length)}) | bold | color(Color::Yellow),
+            text(std::string{text_row.substr(column + length)})
+        })};
+
+        if (index == selected_)
+            row = row | (focused ? inverted : bold);
+        rows.push_back(row | reflect(row_boxes_[static_cast<std::size_t>(index - top_)]));
+    }
+
+    auto const summary{query_.empty()
+        ? std::string{"Type to search the deck"}
+        : std::format("{} matches in {} us", count, std::chrono::duration_cast<std::chrono::microseconds>(search_time_).count())};
+
+    return window(text("Find"), vbox({
+        text(std::format("> {}_", query_)) | bold,
+        separator(),
+        vbox(std::move(rows)) | reflect(box_) | size(HEIGHT, EQUAL, c_SearchRows),
+        separator(),
+        text(summary) | dim
+    })) | size(WIDTH, EQUAL, c_SearchWidth);
+}
+
+bool SearchPanel::OnEvent(ftxui::Event event) {
+    using ftxui::Event;
+
+    if (event.is_mouse())
+        return OnMouseEvent(event);
+
+    if (event == Event::Escape) {
+        if (on_close_)
+            on_close_();
+        return true;
+    }
+
+    if (event == Event::Return) {
+        Jump();
+        return true;
+    }
+
+    if (event == Event::ArrowUp || event == Event::ArrowDown) {
+        Select(selected_ + (event == Event::ArrowUp ? -1 : 1));
+        return true;
+    }
+
+    if (event == Event::PageUp || event == Event::PageDown) {
+        Select(selected_ + (event == Event::PageUp ? -PageSize() : PageSize()));
+        return true;
+    }
+
+    if (event == Event::Backspace) {
+        if (!query_.empty()) {
+            query_.pop_back();
+            selected_ = 0;
+            Refresh();
+        }
+        return true;
+    }
+
+    if (event.is_character()) {
+        auto const &glyph{event.character()};
+        if (glyph.size() != 1 || glyph[0] < ' ' || glyph[0] > '~')
+            return false;
+
+        query_ += glyph;
+        selected_ = 0;
+        Refresh();
+        return true;
+    }
+
+    return false;
+}
+
+bool SearchPanel::OnMouseEvent(ftxui::Event event) {
+    using ftxui::Mouse;
+
+    auto const &mouse{event.mouse()};
+    if (!CaptureMouse(event) || !box_.Contain(mouse.x, mouse.y))
+        return false;
+
+    if (mouse.button == Mouse::WheelUp || mouse.button == Mouse::WheelDown) {
+        Select(selected_ + (mouse.button == Mouse::WheelUp ? -1 : 1));
+        return true;
+    }
+
+    if (mouse.button != Mouse::Left || mouse.motion != Mouse::Pressed)
+        return false;
+
+    for (std::size_t i{0}; i < row_boxes_.size(); ++i) {
+        if (row_boxes_[i].Contain(mouse.x, mouse.y)) {
+            Select(top_ + static_cast<int>(i));
+            Jump();
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <ftxui/component/component_base.hpp>
+#include <ftxui/component/event.hpp>
+#include <ftxui/screen/box.hpp>
+
+#include "search_index.h"
+#include "slide_snapshot.h"
+
+class Deck;
+
+// Searches the deck as the query is typed and lists every match with its row, the match highlighted. Up/Down and the
+// wheel pick a match, Return or a click calls `on_jump` with it, Escape calls `on_close`.
+class SearchPanel final : public ftxui::ComponentBase {
+public:
+    SearchPanel(Deck const &deck, std::function<void(SearchMatch const &)> on_jump, std::function<void()> on_close);
+
+    // Searches again with the last query, for when the panel is shown after the deck has changed.
+    void Refresh();
+
+    ftxui::Element Render() override;
+    bool OnEvent(ftxui::Event event) override;
+
+    [[nodiscard]]
+    bool Focusable() const override {
+        return true;
+    }
+
+private:
+    Deck const &deck_;
+    std::function<void(SearchMatch const &)> on_jump_;
+    std::function<void()> on_close_;
+    std::string query_;
+    std::vector<SearchMatch> matches_;
+    // The deck the matches were found in. Undo and redo still work while the panel is shown.
+    DeckSnapshot searched_;
+    std::chrono::nanoseconds search_time_{};
+    int selected_{0};
+    // The first match in view.
+    int top_{0};
+    ftxui::Box box_;
+    std::vector<ftxui::Box> row_boxes_;
+
+    [[nodiscard]]
+    int PageSize() const noexcept;
+
+    void Select(int index);
+    void Jump();
+    bool OnMouseEvent(ftxui::Event event);
+};
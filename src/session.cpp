@@ -0,0 +1,179 @@
+#include "session.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "deck_io.h"
+#include "export.h"
+#include "trace.h"
+
+namespace {
+    // Header, cursor positions and cache entries as native-endian words, then the slide grids exactly as they are in
+    // memory and the cached encodings back to back. Snapshots are machine-local, so there is no byte swapping.
+    constexpr std::string_view c_SessionMagic{"NESSESS2"};
+
+    struct SessionHeader final {
+        std::uint32_t slide_count;
+        std::uint32_t current_slide;
+        std::uint32_t cache_entry_count;
+    };
+
+    struct CursorRecord final {
+        std::uint16_t row;
+        std::uint16_t column;
+    };
+
+    struct CacheEntryHeader final {
+        std::uint32_t slide_index;
+        std::uint32_t encoded_size;
+    };
+
+    template<typename T>
+    void Put(std::string &out, T const &value) {
+        out.append(reinterpret_cast<char const *>(&value), sizeof(value));
+    }
+
+    class Reader final {
+    public:
+        explicit Reader(std::string_view bytes)
+            : bytes_{bytes} {
+        }
+
+        template<typename T>
+        [[nodiscard]]
+        bool Get(T &value) {
+            if (bytes_.size() < sizeof(value))
+                return false;
+
+            std::memcpy(&value, bytes_.data(), sizeof(value));
+            bytes_.remove_prefix(sizeof(value));
+            return true;
+        }
+
+        // Whether `count` records of `size` bytes are left. Counts come from the file, so this is checked before any is
+        // used to size an allocation.
+        [[nodiscard]]
+        bool Holds(std::size_t count, std::size_t size) const noexcept {
+            return count <= bytes_.size() / size;
+        }
+
+        [[nodiscard]]
+        bool Take(std::size_t size, std::string_view &out) {
+            if (bytes_.size() < size)
+                return false;
+
+            out = bytes_.substr(0, size);
+            bytes_.remove_prefix(size);
+            return true;
+        }
+
+    private:
+        std::string_view bytes_;
+    };
+}
+
+bool SaveSession(std::filesystem::path const &path, DeckSnapshot const &slides, EditorState const &state, ExportCache const &cache) {
+    NESLIDES_TRACE("session", "SaveSession");
+    std::vector<CacheEntryHeader> entries;
+    std::vector<ExportCache::Encoding> encodings;
+    std::size_t text_size{slides.size() * sizeof(SlideGrid)};
+
+    slides.ForEach([&](std::size_t i, SlideSnapshot const &slide) {
+        if (auto const encoded{cache.Find(*slide.grid)}) {
+            entries.push_back({static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(encoded->size())});
+            encodings.push_back(encoded);
+            text_size += encoded->size();
+        }
+    });
+
+    std::string bytes{c_SessionMagic};
+    bytes.reserve(c_SessionMagic.size() + sizeof(SessionHeader) + slides.size() * sizeof(CursorRecord) +
+                  entries.size() * sizeof(CacheEntryHeader) + text_size);
+
+    Put(bytes, SessionHeader{
+        static_cast<std::uint32_t>(slides.size()),
+        static_cast<std::uint32_t>(state.current_slide),
+        static_cast<std::uint32_t>(entries.size())
+    });
+
+    for (std::size_t i{0}; i < slides.size(); ++i) {
+        GridCursor const cursor{i < state.cursor_positions.size() ? state.cursor_positions[i] : GridCursor{}};
+        Put(bytes, CursorRecord{static_cast<std::uint16_t>(cursor.row), static_cast<std::uint16_t>(cursor.column)});
+    }
+
+    for (auto const &entry : entries)
+        Put(bytes, entry);
+
+    slides.ForEach([&](std::size_t, SlideSnapshot const &slide) {
+        bytes.append(slide.grid->Bytes());
+    });
+
+    for (auto const &encoded : encodings)
+        bytes.append(*encoded);
+
+    // Written aside and renamed over, a crash mid-write must not cost the previous snapshot.
+    std::filesystem::path temporary_path{path};
+    temporary_path += ".tmp";
+    if (!WriteFile(temporary_path, bytes))
+        return false;
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    return !error;
+}
+
+bool LoadSession(std::filesystem::path const &path, Slides &slides, EditorState &state, ExportCache &cache) {
+    NESLIDES_TRACE("session", "LoadSession");
+    std::string bytes;
+    if (!ReadFile(path, bytes) || !std::string_view{bytes}.starts_with(c_SessionMagic))
+        return false;
+
+    Reader reader{std::string_view{bytes}.substr(c_SessionMagic.size())};
+
+    SessionHeader header{};
+    if (!reader.Get(header) || header.slide_count == 0 || header.current_slide >= header.slide_count)
+        return false;
+
+    if (!reader.Holds(header.slide_count, sizeof(CursorRecord) + sizeof(SlideGrid)))
+        return false;
+
+    std::vector<GridCursor> cursor_positions(header.slide_count);
+    for (auto &position : cursor_positions) {
+        CursorRecord record{};
+        if (!reader.Get(record))
+            return false;
+        position = {record.row, record.column};
+    }
+
+    if (!reader.Holds(header.cache_entry_count, sizeof(CacheEntryHeader)))
+        return false;
+
+    std::vector<CacheEntryHeader> entries(header.cache_entry_count);
+    for (auto &entry : entries) {
+        if (!reader.Get(entry) || entry.slide_index >= header.slide_count)
+            return false;
+    }
+
+    std::string_view grids;
+    if (!reader.Take(header.slide_count * sizeof(SlideGrid), grids))
+        return false;
+
+    Slides restored(header.slide_count, slides.get_allocator());
+    std::memcpy(restored.data(), grids.data(), grids.size());
+    if (!std::ranges::all_of(restored, &SlideGrid::IsValid))
+        return false;
+
+    for (auto const &entry : entries) {
+        std::string_view encoded;
+        if (!reader.Take(entry.encoded_size, encoded))
+            return false;
+        cache.Insert(restored[entry.slide_index], std::string{encoded});
+    }
+
+    slides = std::move(restored);
+    state.current_slide = static_cast<int>(header.current_slide);
+    state.cursor_positions = std::move(cursor_positions);
+    return true;
+}
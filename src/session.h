@@ -0,0 +1,29 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+#include "slides.h"
+#include "slide_snapshot.h"
+
+class ExportCache;
+
+constexpr std::string_view c_SessionFileName{"last.session"};
+
+// While editing, the session is also saved in the background at most this often.
+constexpr std::chrono::seconds c_AutosaveInterval{30};
+
+struct EditorState final {
+    int current_slide{0};
+    std::vector<GridCursor> cursor_positions;
+};
+
+// The snapshot is the deck's raw slide grids, the editor state and the export cache entries of the deck's slides in
+// one flat buffer. It is written from a deck snapshot, on exit and by the background autosave, and read back with a
+// single read on startup.
+[[nodiscard]]
+bool SaveSession(std::filesystem::path const &path, DeckSnapshot const &slides, EditorState const &state, ExportCache const &cache);
+
+[[nodiscard]]
+bool LoadSession(std::filesystem::path const &path, Slides &slides, EditorState &state, ExportCache &cache);
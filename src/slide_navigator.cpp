@@ -0,0 +1,233 @@
+#include "slide_navigator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <format>
+#include <string>
+
+#include <ftxui/component/mouse.hpp>
+#include <ftxui/dom/elements.hpp>
+
+#include "deck.h"
+
+namespace {
+    // Used until the list has been laid out once.
+    constexpr int c_DefaultPageSize{c_MaxRows};
+
+    // xterm modifier sequences, FTXUI has no events for these.
+    ftxui::Event const c_ShiftArrowUp{ftxui::Event::Special("\x1B[1;2A")};
+    ftxui::Event const c_ShiftArrowDown{ftxui::Event::Special("\x1B[1;2B")};
+    ftxui::Event const c_AltArrowUp{ftxui::Event::Special("\x1B[1;3A")};
+    ftxui::Event const c_AltArrowDown{ftxui::Event::Special("\x1B[1;3B")};
+}
+
+SlideNavigator::SlideNavigator(Deck const &deck, int &selected, std::function<void(int)> on_move)
+    : deck_{deck}
+    , selected_{selected}
+    , on_move_{std::move(on_move)}
+    , anchor_{selected}
+    , last_selected_{selected} {
+}
+
+std::pair<int, int> SlideNavigator::Selection() const noexcept {
+    if (selected_ != last_selected_)
+        return {selected_, 1};
+
+    int const count{static_cast<int>(deck_.Size())};
+    int const first{std::clamp(std::min(selected_, anchor_), 0, count - 1)};
+    int const last{std::clamp(std::max(selected_, anchor_), 0, count - 1)};
+    return {first, last - first + 1};
+}
+
+void SlideNavigator::SetSelection(int first, int count) {
+    selected_ = first;
+    anchor_ = first + count - 1;
+    last_selected_ = selected_;
+    follow_selection_ = true;
+}
+
+void SlideNavigator::Sync() {
+    if (selected_ != last_selected_)
+        anchor_ = last_selected_ = selected_;
+}
+
+int SlideNavigator::PageSize() const noexcept {
+    int const height{box_.y_max - box_.y_min + 1};
+    return height > 1 ? height : c_DefaultPageSize;
+}
+
+void SlideNavigator::Select(int index, bool extend) {
+    selected_ = std::clamp(index, 0, static_cast<int>(deck_.Size()) - 1);
+    last_selected_ = selected_;
+    if (!extend)
+        anchor_ = selected_;
+    follow_selection_ = true;
+}
+
+void SlideNavigator::Scroll(int rows) {
+    top_ += rows;
+    follow_selection_ = false;
+}
+
+ftxui::Element SlideNavigator::Render() {
+    using namespace ftxui;
+
+    int const count{static_cast<int>(deck_.Size())};
+    int const page{PageSize()};
+    selected_ = std::clamp(selected_, 0, count - 1);
+    Sync();
+    auto const [first, selected_count]{Selection()};
+
+    if (follow_selection_) {
+        if (selected_ < top_)
+            top_ = selected_;
+        else if (selected_ >= top_ + page)
+            top_ = selected_ - page + 1;
+    }
+    top_ = std::clamp(top_, 0, std::max(count - page, 0));
+
+    int const last{std::min(top_ + page, count)};
+    row_boxes_.resize(static_cast<std::size_t>(last - top_));
+
+    Elements rows;
+    rows.reserve(row_boxes_.size() + 1);
+    bool const focused{Focused()};
+    for (int index{top_}; index < last; ++index) {
+        auto const &slide{deck_[static_cast<std::size_t>(index)]};
+        auto row{hbox({
+            text(Deck::Title(static_cast<std::size_t>(index))),
+            text(" "),
+            text(std::string{slide.Row(0)}) | dim
+        })};
+
+        if (deck_.Metrics()[static_cast<std::size_t>(index)].overflows)
+            row = row | color(Color::Red);
+
+        if (index == selected_)
+            row = row | (focused ? inverted : bold) | (follow_selection_ ? focus : nothing);
+        else if (index >= first && index < first + selected_count)
+            row = row | inverted;
+        rows.push_back(row | reflect(row_boxes_[static_cast<std::size_t>(index - top_)]));
+    }
+
+    if (!jump_.empty())
+        rows.push_back(text(std::format("Go to: {}_", jump_)) | bold);
+
+    return vbox(std::move(rows)) | reflect(box_) | yflex;
+}
+
+bool SlideNavigator::OnEvent(ftxui::Event event) {
+    using ftxui::Event;
+
+    Sync();
+    if (event.is_mouse())
+        return OnMouseEvent(event);
+
+    if (!Focused())
+        return false;
+
+    int const page{PageSize()};
+
+    if (event == c_ShiftArrowUp || event == c_ShiftArrowDown) {
+        Select(selected_ + (event == c_ShiftArrowUp ? -1 : 1), true);
+        return true;
+    }
+
+    if (event == c_AltArrowUp || event == c_AltArrowDown) {
+        if (on_move_)
+            on_move_(Selection().first + (event == c_AltArrowUp ? -1 : 1));
+        return true;
+    }
+
+    if (event.is_character() && event.character().size() == 1 && std::isdigit(static_cast<unsigned char>(event.character().front()))) {
+        if (jump_.size() < 9)
+            jump_ += event.character();
+        return true;
+    }
+
+    if (!jump_.empty()) {
+        if (event == Event::Return)
+            Select(std::stoi(jump_));
+        if (event == Event::Return || event == Event::Escape || event == Event::Backspace) {
+            if (event == Event::Backspace)
+                jump_.pop_back();
+            else
+                jump_.clear();
+            return true;
+        }
+    }
+
+    if (event == Event::ArrowUp || event == Event::ArrowDown) {
+        int const next{selected_ + (event == Event::ArrowUp ? -1 : 1)};
+        if (next < 0 || next >= static_cast<int>(deck_.Size()))
+            return false;
+
+        Select(next);
+        return true;
+    }
+
+    if (event == Event::PageUp || event == Event::PageDown) {
+        Select(selected_ + (event == Event::PageUp ? -page : page));
+        return true;
+    }
+
+    if (event == Event::Home || event == Event::End) {
+        Select(event == Event::Home ? 0 : static_cast<int>(deck_.Size()) - 1);
+        return true;
+    }
+
+    return false;
+}
+
+bool SlideNavigator::OnMouseEvent(ftxui::Event event) {
+    using ftxui::Mouse;
+
+    // A drag holds the mouse until the button is released, whatever is under the pointer meanwhile.
+    auto const &mouse{event.mouse()};
+    bool const dragging{drag_capture_ != nullptr};
+    if (!dragging && (!CaptureMouse(event) || !box_.Contain(mouse.x, mouse.y)))
+        return false;
+
+    if (mouse.button == Mouse::WheelUp || mouse.button == Mouse::WheelDown) {
+        Scroll(mouse.button == Mouse::WheelUp ? -1 : 1);
+        return true;
+    }
+
+    if (mouse.button != Mouse::Left)
+        return dragging;
+
+    int row{-1};
+    for (std::size_t i{0}; i < row_boxes_.size(); ++i) {
+        if (row_boxes_[i].Contain(mouse.x, mouse.y))
+            row = top_ + static_cast<int>(i);
+    }
+
+    // Pressing inside a selected block keeps it, so it can be dragged as a whole. With the button held, terminals
+    // report motion as more presses.
+    if (mouse.motion == Mouse::Pressed) {
+        if (dragging)
+            return true;
+        if (row < 0)
+            return false;
+
+        auto const [first, count]{Selection()};
+        if (row < first || row >= first + count)
+            Select(row);
+        drag_from_ = row;
+        drag_capture_ = CaptureMouse(event);
+        TakeFocus();
+        return true;
+    }
+
+    if (mouse.motion != Mouse::Released)
+        return dragging;
+
+    drag_capture_.reset();
+    int const from{std::exchange(drag_from_, -1)};
+    if (from < 0 || row < 0 || row == from)
+        return false;
+
+    if (on_move_)
+        on_move_(Selection().first + row - from);
+    return true;
+}
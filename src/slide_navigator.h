@@ -0,0 +1,66 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ftxui/component/captured_mouse.hpp>
+#include <ftxui/component/component_base.hpp>
+#include <ftxui/component/event.hpp>
+#include <ftxui/screen/box.hpp>
+
+class Deck;
+
+constexpr int c_NavigatorWidth{24};
+
+// The list of slides beside the editor. Only the rows in view are built, so a frame costs the same for a deck of ten
+// slides or ten thousand. Arrows, Page Up/Down, Home/End and the wheel scroll it, typing a number and Return jumps
+// straight to that slide.
+//
+// Shift+Up/Down extends the selection to a block of slides. Alt+Up/Down and dragging with the mouse ask for the
+// selection to be moved through `on_move`, called with the index the block should start at.
+class SlideNavigator final : public ftxui::ComponentBase {
+public:
+    SlideNavigator(Deck const &deck, int &selected, std::function<void(int)> on_move = {});
+
+    // The first slide and the number of slides selected.
+    [[nodiscard]]
+    std::pair<int, int> Selection() const noexcept;
+
+    // Selects the block, with the current slide at its start.
+    void SetSelection(int first, int count);
+
+    ftxui::Element Render() override;
+    bool OnEvent(ftxui::Event event) override;
+
+    [[nodiscard]]
+    bool Focusable() const override {
+        return true;
+    }
+
+private:
+    Deck const &deck_;
+    int &selected_;
+    std::function<void(int)> on_move_;
+    // The other end of the selected block, the current slide when a single slide is selected. Reset whenever the
+    // current slide is changed from outside.
+    int anchor_{0};
+    int last_selected_{0};
+    int drag_from_{-1};
+    ftxui::CapturedMouse drag_capture_;
+    // The first slide in view. Follows the selection, but the wheel scrolls it on its own.
+    int top_{0};
+    bool follow_selection_{true};
+    std::string jump_;
+    ftxui::Box box_;
+    std::vector<ftxui::Box> row_boxes_;
+
+    [[nodiscard]]
+    int PageSize() const noexcept;
+
+    void Select(int index, bool extend = false);
+    void Sync();
+    void Scroll(int rows);
+    bool OnMouseEvent(ftxui::Event event);
+};
@@ -0,0 +1,166 @@
+#include "slide_overview.h"
+
+#include <algorithm>
+
+#include <ftxui/component/mouse.hpp>
+#include <ftxui/dom/elements.hpp>
+
+#include "deck.h"
+#include "thumbnail_cache.h"
+
+namespace {
+    // A thumbnail in its border, and a column of space after it.
+    constexpr int c_TileWidth{c_ThumbnailWidth + 3};
+    constexpr int c_TileHeight{c_ThumbnailHeight + 2};
+
+    // Used until the grid has been laid out once.
+    constexpr int c_DefaultColumns{4};
+    constexpr int c_DefaultRows{3};
+}
+
+SlideOverview::SlideOverview(Deck const &deck, int &selected, ThumbnailCache &thumbnails, std::function<void()> on_open)
+    : deck_{deck}
+    , selected_{selected}
+    , thumbnails_{thumbnails}
+    , on_open_{std::move(on_open)} {
+}
+
+int SlideOverview::Columns() const noexcept {
+    int const width{box_.x_max - box_.x_min + 1};
+    return width > 1 ? std::max(width / c_TileWidth, 1) : c_DefaultColumns;
+}
+
+int SlideOverview::VisibleRows() const noexcept {
+    int const height{box_.y_max - box_.y_min + 1};
+    return height > 1 ? std::max(height / c_TileHeight, 1) : c_DefaultRows;
+}
+
+void SlideOverview::Select(int index) {
+    selected_ = std::clamp(index, 0, static_cast<int>(deck_.Size()) - 1);
+    follow_selection_ = true;
+}
+
+ftxui::Element SlideOverview::Render() {
+    using namespace ftxui;
+
+    int const count{static_cast<int>(deck_.Size())};
+    int const columns{Columns()};
+    int const visible_rows{VisibleRows()};
+    int const row_count{(count + columns - 1) / columns};
+    selected_ = std::clamp(selected_, 0, count - 1);
+
+    if (follow_selection_) {
+        int const selected_row{selected_ / columns};
+        if (selected_row < top_row_)
+            top_row_ = selected_row;
+        else if (selected_row >= top_row_ + visible_rows)
+            top_row_ = selected_row - visible_rows + 1;
+    }
+    top_row_ = std::clamp(top_row_, 0, std::max(row_count - visible_rows, 0));
+
+    int const first{top_row_ * columns};
+    int const last{std::min((top_row_ + visible_rows) * columns, count)};
+    tile_boxes_.resize(static_cast<std::size_t>(std::max(last - first, 0)));
+
+    Elements rows;
+    bool const focused{Focused()};
+    for (int row_start{first}; row_start < last; row_start += columns) {
+        Elements tiles;
+        for (int index{row_start}; index < std::min(row_start + columns, last); ++index) {
+            auto const slide{static_cast<std::size_t>(index)};
+
+            Elements lines;
+            if (auto const thumbnail{thumbnails_.Get(deck_[slide])}) {
+                for (auto const &line : *thumbnail)
+                    lines.push_back(text(line));
+            } else {
+                lines.push_back(text("...") | dim);
+            }
+
+            auto tile{window(text(Deck::Title(slide)), vbox(std::move(lines)) | size(WIDTH, EQUAL, c_ThumbnailWidth) | size(HEIGHT, EQUAL, c_ThumbnailHeight))};
+            if (deck_.Metrics()[slide].overflows)
+                tile = tile | color(Color::Red);
+            if (index == selected_)
+                tile = tile | (focused ? inverted : bold) | (follow_selection_ ? focus : nothing);
+
+            tiles.push_back(tile | reflect(tile_boxes_[static_cast<std::size_t>(index - first)]));
+            tiles.push_back(text(" "));
+        }
+        rows.push_back(hbox(std::move(tiles)));
+    }
+
+    return vbox(std::move(rows)) | reflect(box_) | flex;
+}
+
+bool SlideOverview::OnEvent(ftxui::Event event) {
+    using ftxui::Event;
+
+    if (event.is_mouse())
+        return OnMouseEvent(event);
+
+    if (!Focused())
+        return false;
+
+    int const columns{Columns()};
+
+    if (event == Event::ArrowLeft || event == Event::ArrowRight) {
+        Select(selected_ + (event == Event::ArrowLeft ? -1 : 1));
+        return true;
+    }
+
+    if (event == Event::ArrowUp || event == Event::ArrowDown) {
+        Select(selected_ + (event == Event::ArrowUp ? -columns : columns));
+        return true;
+    }
+
+    if (event == Event::PageUp || event == Event::PageDown) {
+        int const page{columns * VisibleRows()};
+        Select(selected_ + (event == Event::PageUp ? -page : page));
+        return true;
+    }
+
+    if (event == Event::Home || event == Event::End) {
+        Select(event == Event::Home ? 0 : static_cast<int>(deck_.Size()) - 1);
+        return true;
+    }
+
+    if (event == Event::Return) {
+        if (on_open_)
+            on_open_();
+        return true;
+    }
+
+    return false;
+}
+
+bool SlideOverview::OnMouseEvent(ftxui::Event event) {
+    using ftxui::Mouse;
+
+    auto const &mouse{event.mouse()};
+    if (!CaptureMouse(event) || !box_.Contain(mouse.x, mouse.y))
+        return false;
+
+    if (mouse.button == Mouse::WheelUp || mouse.button == Mouse::WheelDown) {
+        top_row_ += mouse.button == Mouse::WheelUp ? -1 : 1;
+        follow_selection_ = false;
+        return true;
+    }
+
+    if (mouse.button != Mouse::Left || mouse.motion != Mouse::Pressed)
+        return false;
+
+    for (std::size_t i{0}; i < tile_boxes_.size(); ++i) {
+        if (!tile_boxes_[i].Contain(mouse.x, mouse.y))
+            continue;
+
+        int const index{top_row_ * Columns() + static_cast<int>(i)};
+        TakeFocus();
+        if (index == selected_ && on_open_)
+            on_open_();
+        else
+            Select(index);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <ftxui/component/component_base.hpp>
+#include <ftxui/component/event.hpp>
+#include <ftxui/screen/box.hpp>
+
+class Deck;
+class ThumbnailCache;
+
+// A grid of slide thumbnails, as many columns as fit. Like the navigator it only builds the rows in view, and asks
+// the cache for nothing else, so scrolling a deck of thousands of slides costs the same as a deck of ten.
+//
+// Arrows, Page Up/Down, Home/End and the wheel move around the grid. Return, or clicking the selected slide, calls
+// `on_open`.
+class SlideOverview final : public ftxui::ComponentBase {
+public:
+    SlideOverview(Deck const &deck, int &selected, ThumbnailCache &thumbnails, std::function<void()> on_open = {});
+
+    ftxui::Element Render() override;
+    bool OnEvent(ftxui::Event event) override;
+
+    [[nodiscard]]
+    bool Focusable() const override {
+        return true;
+    }
+
+private:
+    Deck const &deck_;
+    int &selected_;
+    ThumbnailCache &thumbnails_;
+    std::function<void()> on_open_;
+    // The first row of thumbnails in view. Follows the selection, but the wheel scrolls it on its own.
+    int top_row_{0};
+    bool follow_selection_{true};
+    ftxui::Box box_;
+    std::vector<ftxui::Box> tile_boxes_;
+
+    [[nodiscard]]
+    int Columns() const noexcept;
+    [[nodiscard]]
+    int VisibleRows() const noexcept;
+
+    void Select(int index);
+    bool OnMouseEvent(ftxui::Event event);
+};
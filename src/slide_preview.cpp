@@ -0,0 +1,163 @@
+#include "slide_preview.h"
+
+#include <cctype>
+#include <cstdint>
+#include <format>
+
+#include "braille.h"
+#include "export.h"
+
+namespace {
+    // The 8x8 font of U+0020 to U+005F, one byte per pixel row, least significant bit leftmost. The engine only has
+    // uppercase glyphs, exported text is uppercased first.
+    constexpr std::array<std::array<std::uint8_t, 8>, 64> c_Font{{
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+        {0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00},
+        {0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+        {0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00},
+        {0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00},
+        {0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00},
+        {0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00},
+        {0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00},
+        {0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00},
+        {0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00},
+        {0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00},
+        {0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00},
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06},
+        {0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00},
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00},
+        {0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00},
+        {0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00},
+        {0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00},
+        {0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00},
+        {0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00},
+        {0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00},
+        {0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00},
+        {0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00},
+        {0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00},
+        {0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00},
+        {0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00},
+        {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00},
+        {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06},
+        {0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00},
+        {0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00},
+        {0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00},
+        {0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00},
+        {0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00},
+        {0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00},
+        {0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00},
+        {0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00},
+        {0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00},
+        {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00},
+        {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00},
+        {0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00},
+        {0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00},
+        {0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},
+        {0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00},
+        {0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00},
+        {0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00},
+        {0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00},
+        {0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00},
+        {0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00},
+        {0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00},
+        {0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00},
+        {0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00},
+        {0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00},
+        {0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},
+        {0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00},
+        {0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00},
+        {0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00},
+        {0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00},
+        {0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00},
+        {0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00},
+        {0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00},
+        {0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00},
+        {0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00},
+        {0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00},
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF}
+    }};
+
+    // Glyphs the font does not have show as a filled tile.
+    constexpr std::array<std::uint8_t, 8> c_MissingGlyph{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    constexpr std::size_t c_MissingGlyphIndex{c_Font.size()};
+
+    [[nodiscard]]
+    std::size_t GlyphIndex(char glyph) noexcept {
+        auto const upper{std::toupper(static_cast<unsigned char>(glyph))};
+        return upper >= 0x20 && upper < 0x60 ? static_cast<std::size_t>(upper - 0x20) : c_MissingGlyphIndex;
+    }
+
+    std::string const c_BlankTile(c_PreviewCellsPerTile, ' ');
+}
+
+std::string const &SlidePreview::Tile(char glyph, TileRows rows) {
+    std::size_t const glyph_index{GlyphIndex(glyph)};
+    std::size_t const index{glyph_index * 3 + static_cast<std::size_t>(rows)};
+    if (drawn_[index])
+        return tiles_[index];
+
+    auto const &pixels{glyph_index < c_Font.size() ? c_Font[glyph_index] : c_MissingGlyph};
+
+    // The four pixel rows shown by the four dot rows of the cells.
+    std::array<std::uint8_t, 4> shown{};
+    for (std::size_t dot_row{0}; dot_row < shown.size(); ++dot_row) {
+        switch (rows) {
+        case TileRows::Whole:
+            shown[dot_row] = pixels[dot_row * 2] | pixels[dot_row * 2 + 1];
+            break;
+        case TileRows::TopHalf:
+            shown[dot_row] = pixels[dot_row];
+            break;
+        case TileRows::BottomHalf:
+            shown[dot_row] = pixels[dot_row + 4];
+            break;
+        }
+    }
+
+    auto &tile{tiles_[index]};
+    for (int cell{0}; cell < c_PreviewCellsPerTile; ++cell) {
+        std::uint8_t dots{0};
+        for (std::size_t dot_row{0}; dot_row < shown.size(); ++dot_row) {
+            for (std::size_t dot_column{0}; dot_column < 2; ++dot_column) {
+                if ((shown[dot_row] >> (cell * 2 + static_cast<int>(dot_column))) & 1)
+                    dots |= c_BrailleDots[dot_row][dot_column];
+            }
+        }
+        AppendBraille(tile, dots);
+    }
+
+    drawn_[index] = true;
+    return tile;
+}
+
+ftxui::Element SlidePreview::Render(SlideGrid const &slide) {
+    using namespace ftxui;
+
+    Elements lines;
+    lines.reserve(c_MaxRows);
+
+    auto const draw_line{[&](int row, TileRows rows) {
+        if (static_cast<int>(lines.size()) == c_MaxRows)
+            return;
+
+        std::string line;
+        line.reserve(c_MaxColumns * c_PreviewCellsPerTile * 3);
+        for (int column{0}; column < c_MaxColumns; ++column)
+            line += column < slide.row_lengths[row] ? Tile(slide.glyphs[row][column], rows) : c_BlankTile;
+        lines.push_back(text(std::move(line)));
+    }};
+
+    int const row_count{EncodedRowCount(slide)};
+    for (int row{0}; row < row_count; ++row) {
+        if (slide.IsBigText(row)) {
+            draw_line(row, TileRows::TopHalf);
+            draw_line(row, TileRows::BottomHalf);
+        } else {
+            draw_line(row, TileRows::Whole);
+        }
+    }
+
+    int const cut_off{ScreenRowCount(slide) - c_MaxRows};
+    auto title{cut_off > 0 ? text(std::format("Preview - {} rows off screen", cut_off)) | color(Color::Red) : text("Preview")};
+    return window(std::move(title), vbox(std::move(lines)) | size(HEIGHT, EQUAL, c_MaxRows));
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <string>
+
+#include <ftxui/dom/elements.hpp>
+
+#include "slides.h"
+
+// Braille cells per tile column: 8 pixels wide, 2 pixels per cell.
+constexpr int c_PreviewCellsPerTile{4};
+constexpr int c_PreviewWidth{c_MaxColumns * c_PreviewCellsPerTile + 2};
+
+// Draws a slide as the NES shows it: uppercase glyphs of an 8x8 font on the 26-column safe area, BIG_TEXT rows at
+// double height. Rows past the bottom of the screen are cut off, as they are on the console.
+//
+// Each tile row is one line of braille cells. Normal rows keep every pixel column and every other pixel row, big rows
+// keep every pixel. Tiles are drawn once and reused, so redrawing after a keystroke only concatenates strings.
+class SlidePreview final {
+public:
+    [[nodiscard]]
+    ftxui::Element Render(SlideGrid const &slide);
+
+private:
+    // Which pixel rows of the glyph a tile shows.
+    enum class TileRows {
+        Whole,
+        TopHalf,
+        BottomHalf
+    };
+
+    static constexpr std::size_t c_GlyphCount{65};
+    static constexpr std::size_t c_TileCount{c_GlyphCount * 3};
+
+    std::array<std::string, c_TileCount> tiles_;
+    std::bitset<c_TileCount> drawn_;
+
+    [[nodiscard]]
+    std::string const &Tile(char glyph, TileRows rows);
+};
@@ -0,0 +1,23 @@
+#include "slide_snapshot.h"
+
+#include <cassert>
+
+SlideSnapshot SnapshotSlide(SlideId id, SlideGrid const &slide) {
+    return {id, std::make_shared<SlideGrid const>(slide)};
+}
+
+DeckSnapshot SnapshotDeck(Slides const &slides, std::vector<SlideId> const &ids) {
+    assert(slides.size() == ids.size());
+
+    DeckSnapshot snapshot;
+    if (slides.empty())
+        return snapshot;
+
+    std::shared_ptr<SlideGrid[]> const block{new SlideGrid[slides.size()]};
+    for (std::size_t i{0}; i < slides.size(); ++i) {
+        block[i] = slides[i];
+        snapshot.PushBack({ids[i], {block, &block[i]}});
+    }
+
+    return snapshot;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "persistent_vector.h"
+#include "slides.h"
+
+// An immutable copy of a slide and the id of the slide it was taken from. The grid is shared, never edited, so it can
+// be handed to other threads.
+struct SlideSnapshot final {
+    SlideId id{};
+    std::shared_ptr<SlideGrid const> grid;
+
+    bool operator==(SlideSnapshot const &) const = default;
+};
+
+// An immutable view of a whole deck that shares every unchanged slide and leaf with the snapshot it was derived from.
+// Copying one costs a pointer per 64 slides, updating one after an edit costs a slide and a leaf.
+using DeckSnapshot = PersistentVector<SlideSnapshot>;
+
+[[nodiscard]]
+SlideSnapshot SnapshotSlide(SlideId id, SlideGrid const &slide);
+
+// Copies every slide into a single shared block, the slide snapshots alias into it.
+[[nodiscard]]
+DeckSnapshot SnapshotDeck(Slides const &slides, std::vector<SlideId> const &ids);
@@ -0,0 +1,157 @@
+#include "slides.h"
+
+#include <algorithm>
+
+void SlideGrid::SetBigText(int row, bool big) noexcept {
+    if (big)
+        row_attributes[row] |= RowAttributeBigText;
+    else
+        row_attributes[row] &= ~RowAttributeBigText;
+}
+
+bool SlideGrid::InsertGlyph(int row, int column, char glyph) noexcept {
+    auto &length{row_lengths[row]};
+    if (length == c_MaxColumns || column > length)
+        return false;
+
+    auto &cells{glyphs[row]};
+    std::copy_backward(cells.begin() + column, cells.begin() + length, cells.begin() + length + 1);
+    cells[column] = glyph;
+    ++length;
+    return true;
+}
+
+bool SlideGrid::EraseGlyph(int row, int column) noexcept {
+    auto &length{row_lengths[row]};
+    if (column >= length)
+        return false;
+
+    auto &cells{glyphs[row]};
+    std::copy(cells.begin() + column + 1, cells.begin() + length, cells.begin() + column);
+    cells[--length] = '\0';
+    return true;
+}
+
+bool SlideGrid::SplitRow(int row, int column) noexcept {
+    if (row_count == c_MaxRows || column > row_lengths[row])
+        return false;
+
+    std::copy_backward(glyphs.begin() + row + 1, glyphs.begin() + row_count, glyphs.begin() + row_count + 1);
+    std::copy_backward(row_lengths.begin() + row + 1, row_lengths.begin() + row_count, row_lengths.begin() + row_count + 1);
+    std::copy_backward(row_attributes.begin() + row + 1, row_attributes.begin() + row_count, row_attributes.begin() + row_count + 1);
+    ++row_count;
+
+    auto &cells{glyphs[row]};
+    auto &next{glyphs[row + 1]};
+    int const moved{row_lengths[row] - column};
+    next.fill('\0');
+    std::copy_n(cells.begin() + column, moved, next.begin());
+    std::fill_n(cells.begin() + column, moved, '\0');
+    row_lengths[row + 1] = static_cast<std::uint8_t>(moved);
+    row_lengths[row] = static_cast<std::uint8_t>(column);
+    row_attributes[row + 1] = row_attributes[row];
+    return true;
+}
+
+bool SlideGrid::JoinRows(int row) noexcept {
+    if (row + 1 >= row_count || row_lengths[row] + row_lengths[row + 1] > c_MaxColumns)
+        return false;
+
+    std::copy_n(glyphs[row + 1].begin(), row_lengths[row + 1], glyphs[row].begin() + row_lengths[row]);
+    row_lengths[row] += row_lengths[row + 1];
+
+    std::copy(glyphs.begin() + row + 2, glyphs.begin() + row_count, glyphs.begin() + row + 1);
+    std::copy(row_lengths.begin() + row + 2, row_lengths.begin() + row_count, row_lengths.begin() + row + 1);
+    std::copy(row_attributes.begin() + row + 2, row_attributes.begin() + row_count, row_attributes.begin() + row + 1);
+    --row_count;
+
+    glyphs[row_count].fill('\0');
+    row_lengths[row_count] = 0;
+    row_attributes[row_count] = RowAttributeNone;
+    return true;
+}
+
+bool SlideGrid::AssignText(std::string_view text) noexcept {
+    *this = SlideGrid{};
+    row_count = 0;
+
+    auto const start_row{[this](bool big) {
+        if (row_count == c_MaxRows)
+            return false;
+
+        SetBigText(row_count++, big);
+        return true;
+    }};
+
+    bool kept_all{true};
+    while (true) {
+        auto const line_end{std::min(text.find('\n'), text.size())};
+        std::string_view const line{text.substr(0, line_end)};
+        bool const big{line.find(c_BigTextMarker) != std::string_view::npos};
+
+        if (!start_row(big))
+            return false;
+
+        for (std::size_t i{0}; i < line.size(); ++i) {
+            if (line.substr(i).starts_with(c_BigTextMarker)) {
+                ++i;
+                continue;
+            }
+
+            if (!IsSlideGlyph(line[i])) {
+                kept_all = false;
+                continue;
+            }
+
+            if (row_lengths[row_count - 1] == c_MaxColumns && !start_row(big))
+                return false;
+
+            auto &length{row_lengths[row_count - 1]};
+            glyphs[row_count - 1][length++] = line[i];
+        }
+
+        if (line_end == text.size())
+            return kept_all;
+
+        text.remove_prefix(line_end + 1);
+    }
+}
+
+std::string SlideGrid::Text() const {
+    std::string text;
+    text.reserve(TextSize());
+
+    for (int row{0}; row < row_count; ++row) {
+        if (row != 0)
+            text.push_back('\n');
+        if (IsBigText(row))
+            text.append(c_BigTextMarker);
+        text.append(Row(row));
+    }
+
+    return text;
+}
+
+std::size_t SlideGrid::TextSize() const noexcept {
+    std::size_t size{static_cast<std::size_t>(row_count) - 1};
+    for (int row{0}; row < row_count; ++row)
+        size += row_lengths[row] + (IsBigText(row) ? c_BigTextMarker.size() : 0);
+
+    return size;
+}
+
+bool SlideGrid::IsValid() const noexcept {
+    if (row_count == 0 || row_count > c_MaxRows)
+        return false;
+
+    for (int row{0}; row < c_MaxRows; ++row) {
+        int const length{row < row_count ? row_lengths[row] : 0};
+        if (length > c_MaxColumns || (row >= row_count && (row_lengths[row] != 0 || row_attributes[row] != RowAttributeNone)))
+            return false;
+
+        if (std::any_of(glyphs[row].begin() + length, glyphs[row].end(), [](char c) { return c != '\0'; }))
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+constexpr int c_MaxColumns{26};
+constexpr int c_MaxRows{27};
+
+// The NES screen keeps one row of the safe area free. A grid can still hold c_MaxRows, so a slide past this is flagged
+// as overflowing rather than refused, see DeckMetrics.
+constexpr int c_MaxSlideLines{c_MaxRows - 1};
+
+// What a slide can hold, printable ASCII. Typing and replacing refuse anything else, parsing and importing drop it.
+[[nodiscard]]
+constexpr bool IsSlideGlyph(char glyph) noexcept {
+    return glyph >= ' ' && glyph <= '~';
+}
+
+// Case-insensitive matching compares glyphs folded to uppercase, the case the NES shows.
+[[nodiscard]]
+constexpr char FoldGlyph(char glyph) noexcept {
+    return glyph >= 'a' && glyph <= 'z' ? static_cast<char>(glyph - 'a' + 'A') : glyph;
+}
+
+// Marks a big text row in the text form of a slide, i.e. in .neslides files and imported text.
+constexpr std::string_view c_BigTextMarker{"\\b"};
+
+enum RowAttribute : std::uint8_t {
+    RowAttributeNone = 0,
+    RowAttributeBigText = 1 << 0
+};
+
+// One slide as the NES shows it, a fixed grid of glyphs. Cells past a row's length and rows past row_count are
+// always zero, so two grids with the same content are bytewise equal and can be hashed as raw memory.
+struct SlideGrid final {
+    std::array<std::array<char, c_MaxColumns>, c_MaxRows> glyphs{};
+    std::array<std::uint8_t, c_MaxRows> row_lengths{};
+    std::array<std::uint8_t, c_MaxRows> row_attributes{};
+    std::uint8_t row_count{1};
+
+    [[nodiscard]]
+    std::string_view Row(int row) const noexcept {
+        return {glyphs[row].data(), row_lengths[row]};
+    }
+
+    [[nodiscard]]
+    bool IsBigText(int row) const noexcept {
+        return (row_attributes[row] & RowAttributeBigText) != 0;
+    }
+
+    void SetBigText(int row, bool big) noexcept;
+
+    // Edits keep the grid within its bounds and fail instead of overflowing it.
+    [[nodiscard]]
+    bool InsertGlyph(int row, int column, char glyph) noexcept;
+
+    [[nodiscard]]
+    bool EraseGlyph(int row, int column) noexcept;
+
+    // Moves everything from the column on to a new row below.
+    [[nodiscard]]
+    bool SplitRow(int row, int column) noexcept;
+
+    // Appends the row below to the row.
+    [[nodiscard]]
+    bool JoinRows(int row) noexcept;
+
+    // Rows longer than c_MaxColumns wrap onto the next row, characters a slide cannot hold are dropped. Returns false if
+    // any text was lost, dropped or cut off past c_MaxRows.
+    [[nodiscard]]
+    bool AssignText(std::string_view text) noexcept;
+
+    // The text form, rows separated by newlines with big text rows prefixed by c_BigTextMarker.
+    [[nodiscard]]
+    std::string Text() const;
+
+    [[nodiscard]]
+    std::size_t TextSize() const noexcept;
+
+    [[nodiscard]]
+    bool IsValid() const noexcept;
+
+    [[nodiscard]]
+    std::string_view Bytes() const noexcept {
+        return {reinterpret_cast<char const *>(this), sizeof(*this)};
+    }
+
+    bool operator==(SlideGrid const &) const = default;
+};
+
+static_assert(std::is_trivially_copyable_v<SlideGrid>);
+static_assert(sizeof(SlideGrid) == c_MaxColumns * c_MaxRows + 2 * c_MaxRows + 1, "SlideGrid must not contain padding");
+
+using Slides = std::pmr::vector<SlideGrid>;
+
+// Names a slide for as long as it exists in its deck, whatever its position. Never reused within a deck.
+using SlideId = std::uint32_t;
+
+struct GridCursor final {
+    int row{0};
+    int column{0};
+};
@@ -0,0 +1,41 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned thread_count) {
+    thread_count = std::max(thread_count, 1u);
+    threads_.reserve(thread_count);
+
+    for (unsigned i{0}; i < thread_count; ++i)
+        threads_.emplace_back([this] { WorkerLoop(); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    condition_.notify_all();
+
+    // Join before the queue and its mutex are destroyed, workers drain the remaining tasks first.
+    threads_.clear();
+}
+
+void ThreadPool::WorkerLoop() {
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock lock{mutex_};
+            condition_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+
+            if (tasks_.empty())
+                return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        task();
+    }
+}
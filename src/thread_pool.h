@@ -0,0 +1,49 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool final {
+public:
+    explicit ThreadPool(unsigned thread_count = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const &) = delete;
+    ThreadPool &operator=(ThreadPool const &) = delete;
+
+    template<typename Function>
+    [[nodiscard]]
+    std::future<std::invoke_result_t<Function>> Submit(Function &&function) {
+        auto task{std::make_shared<std::packaged_task<std::invoke_result_t<Function>()>>(std::forward<Function>(function))};
+        auto future{task->get_future()};
+
+        {
+            std::lock_guard lock{mutex_};
+            tasks_.emplace_back([task] { (*task)(); });
+        }
+        condition_.notify_one();
+
+        return future;
+    }
+
+    [[nodiscard]]
+    std::size_t ThreadCount() const noexcept {
+        return threads_.size();
+    }
+
+private:
+    std::vector<std::jthread> threads_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_{false};
+
+    void WorkerLoop();
+};
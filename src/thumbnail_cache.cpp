@@ -0,0 +1,96 @@
+#include "thumbnail_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "braille.h"
+#include "export.h"
+#include "hash.h"
+#include "thread_pool.h"
+
+Thumbnail DrawThumbnail(SlideGrid const &slide) {
+    // The tile rows of the slide as the NES lays them out, big text taking two, as ScreenRowCount counts them.
+    std::array<int, c_MaxRows> tile_rows{};
+    int tile_row_count{0};
+    int const row_count{EncodedRowCount(slide)};
+    for (int row{0}; row < row_count && tile_row_count < c_MaxRows; ++row) {
+        tile_rows[static_cast<std::size_t>(tile_row_count++)] = row;
+        if (slide.IsBigText(row) && tile_row_count < c_MaxRows)
+            tile_rows[static_cast<std::size_t>(tile_row_count++)] = row;
+    }
+
+    auto const lit{[&](int tile_row, int column) {
+        if (tile_row >= tile_row_count || column >= c_MaxColumns)
+            return false;
+        int const row{tile_rows[static_cast<std::size_t>(tile_row)]};
+        return column < slide.row_lengths[row] && slide.glyphs[row][column] != ' ';
+    }};
+
+    Thumbnail thumbnail;
+    for (int line{0}; line < c_ThumbnailHeight; ++line) {
+        auto &text{thumbnail[static_cast<std::size_t>(line)]};
+        text.reserve(c_ThumbnailWidth * 3);
+
+        for (int cell{0}; cell < c_ThumbnailWidth; ++cell) {
+            std::uint8_t dots{0};
+            for (int dot_row{0}; dot_row < 4; ++dot_row) {
+                for (int dot_column{0}; dot_column < 2; ++dot_column) {
+                    if (lit(line * 4 + dot_row, cell * 2 + dot_column))
+                        dots |= c_BrailleDots[static_cast<std::size_t>(dot_row)][static_cast<std::size_t>(dot_column)];
+                }
+            }
+
+            AppendBraille(text, dots);
+        }
+    }
+
+    return thumbnail;
+}
+
+ThumbnailCache::ThumbnailCache(ThreadPool &pool, std::function<void()> on_ready)
+    : pool_{pool}
+    , state_{std::make_shared<State>()} {
+    state_->on_ready = std::move(on_ready);
+}
+
+void ThumbnailCache::DropOldest(State &state) {
+    std::vector<std::uint64_t> used;
+    used.reserve(state.thumbnails.size());
+    for (auto const &[hash, entry] : state.thumbnails)
+        used.push_back(entry.used);
+
+    auto const middle{used.begin() + static_cast<std::ptrdiff_t>(used.size() / 2)};
+    std::ranges::nth_element(used, middle);
+    std::erase_if(state.thumbnails, [cutoff = *middle](auto const &item) { return item.second.used < cutoff; });
+}
+
+std::shared_ptr<Thumbnail const> ThumbnailCache::Get(SlideGrid const &slide) {
+    std::uint64_t const hash{HashBytes(slide.Bytes())};
+
+    {
+        std::lock_guard lock{state_->mutex};
+        auto const [it, inserted]{state_->thumbnails.try_emplace(hash)};
+        it->second.used = ++state_->gets;
+        if (!inserted)
+            return it->second.thumbnail;
+
+        if (state_->thumbnails.size() > c_MaxThumbnails)
+            DropOldest(*state_);
+    }
+
+    // The future is not needed, the task reports back through the state.
+    (void)pool_.Submit([state = state_, hash, slide] {
+        auto thumbnail{std::make_shared<Thumbnail const>(DrawThumbnail(slide))};
+        {
+            std::lock_guard lock{state->mutex};
+            // Dropped while queued, it is asked for again if still needed.
+            if (auto const it{state->thumbnails.find(hash)}; it != state->thumbnails.end())
+                it->second.thumbnail = std::move(thumbnail);
+        }
+        if (state->on_ready)
+            state->on_ready();
+    });
+
+    return nullptr;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "slides.h"
+
+class ThreadPool;
+
+// One braille dot per glyph cell: 26 columns in 13 cells, 27 tile rows in 7 lines.
+constexpr int c_ThumbnailWidth{(c_MaxColumns + 1) / 2};
+constexpr int c_ThumbnailHeight{(c_MaxRows + 3) / 4};
+
+using Thumbnail = std::array<std::string, c_ThumbnailHeight>;
+
+constexpr std::size_t c_MaxThumbnails{4096};
+
+// Downscaled slides for the overview, drawn on the thread pool and kept by content hash, so identical slides share one
+// and editing a slide only costs the thumbnail of its new content. `on_ready` is called on a worker thread whenever a
+// thumbnail is done. Past c_MaxThumbnails the half used longest ago is dropped, so edits and closed decks do not
+// pile up content no slide has any more.
+class ThumbnailCache final {
+public:
+    ThumbnailCache(ThreadPool &pool, std::function<void()> on_ready);
+
+    // The thumbnail of the slide, or null while it is being drawn. The first call for new content queues it.
+    [[nodiscard]]
+    std::shared_ptr<Thumbnail const> Get(SlideGrid const &slide);
+
+private:
+    // Shared with the queued tasks, which may finish after the cache is gone.
+    struct Entry final {
+        // Null while queued.
+        std::shared_ptr<Thumbnail const> thumbnail;
+        // The Get count when it was last asked for.
+        std::uint64_t used{};
+    };
+
+    struct State final {
+        std::function<void()> on_ready;
+        std::mutex mutex;
+        std::unordered_map<std::uint64_t, Entry> thumbnails;
+        std::uint64_t gets{0};
+    };
+
+    ThreadPool &pool_;
+    std::shared_ptr<State> state_;
+
+    // Called with the mutex held.
+    static void DropOldest(State &state);
+};
+
+// Draws the thumbnail on the calling thread.
+[[nodiscard]]
+Thumbnail DrawThumbnail(SlideGrid const &slide);
@@ -0,0 +1,137 @@
+#include "trace.h"
+
+#ifdef NESLIDES_TRACING
+
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "deck_io.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct TraceEvent final {
+        char const *category;
+        char const *name;
+        std::string detail;
+        std::int64_t start;
+        std::int64_t duration;
+    };
+
+    // Each thread appends to its own buffer, the lock is only ever contended while the trace is written.
+    struct ThreadBuffer final {
+        std::mutex mutex;
+        std::vector<TraceEvent> events;
+        std::size_t thread_id{};
+    };
+
+    struct Tracer final {
+        Clock::time_point const origin{Clock::now()};
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    };
+
+    [[nodiscard]]
+    Tracer &GlobalTracer() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    // Creating the tracer fixes its origin, so it is created before the start of the first span is taken, never after.
+    [[nodiscard]]
+    Clock::time_point SpanStart() noexcept {
+        static_cast<void>(GlobalTracer());
+        return Clock::now();
+    }
+
+    [[nodiscard]]
+    ThreadBuffer &LocalBuffer() {
+        thread_local std::shared_ptr<ThreadBuffer> const buffer{[] {
+            auto &tracer{GlobalTracer()};
+            auto created{std::make_shared<ThreadBuffer>()};
+            std::lock_guard lock{tracer.mutex};
+            created->thread_id = tracer.buffers.size() + 1;
+            tracer.buffers.push_back(created);
+            return created;
+        }()};
+        return *buffer;
+    }
+
+    [[nodiscard]]
+    std::int64_t Microseconds(Clock::duration duration) noexcept {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    }
+
+    void AppendEscaped(std::string &out, std::string_view text) {
+        for (char const c : text) {
+            if (c == '"' || c == '\\') {
+                out.push_back('\\');
+                out.push_back(c);
+            } else if (static_cast<unsigned char>(c) < ' ') {
+                out += std::format("\\u{:04x}", static_cast<unsigned>(c));
+            } else {
+                out.push_back(c);
+            }
+        }
+    }
+}
+
+TraceSpan::TraceSpan(char const *category, char const *name, std::string detail) noexcept
+    : category_{category}
+    , name_{name}
+    , detail_{std::move(detail)}
+    , start_{SpanStart()} {
+}
+
+TraceSpan::~TraceSpan() {
+    auto const end{Clock::now()};
+    auto &buffer{LocalBuffer()};
+    std::lock_guard lock{buffer.mutex};
+    buffer.events.push_back({
+        category_,
+        name_,
+        std::move(detail_),
+        Microseconds(start_ - GlobalTracer().origin),
+        Microseconds(end - start_)
+    });
+}
+
+bool WriteTrace(std::filesystem::path const &path) {
+    auto &tracer{GlobalTracer()};
+    std::string json{"{\"traceEvents\":[\n"};
+    bool first{true};
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard lock{tracer.mutex};
+        buffers = tracer.buffers;
+    }
+
+    for (auto const &buffer : buffers) {
+        std::lock_guard buffer_lock{buffer->mutex};
+        for (auto const &event : buffer->events) {
+            json += first ? "" : ",\n";
+            first = false;
+
+            json += std::format(R"({{"ph":"X","pid":1,"tid":{},"ts":{},"dur":{},"cat":")", buffer->thread_id, event.start, event.duration);
+            AppendEscaped(json, event.category);
+            json += R"(","name":")";
+            AppendEscaped(json, event.name);
+            json += '"';
+            if (!event.detail.empty()) {
+                json += R"(,"args":{"detail":")";
+                AppendEscaped(json, event.detail);
+                json += "\"}";
+            }
+            json += '}';
+        }
+    }
+
+    json += "\n]}\n";
+    return WriteFile(path, json);
+}
+
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string_view>
+
+constexpr std::string_view c_TraceFileName{"neslides_trace.json"};
+
+// Scoped spans written as Chrome trace JSON, to be opened in Perfetto or chrome://tracing. Spans are only recorded when
+// configured with -DNESLIDES_TRACING=ON; otherwise the macros expand to nothing and their arguments are not evaluated.
+//
+//     NESLIDES_TRACE("export", "make all");
+//     NESLIDES_TRACE("io", "ReadFile", path.string());
+#ifdef NESLIDES_TRACING
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+// Records the time between its construction and destruction on the calling thread. `category` and `name` must outlive
+// the trace, string literals in practice.
+class TraceSpan final {
+public:
+    TraceSpan(char const *category, char const *name, std::string detail = {}) noexcept;
+    ~TraceSpan();
+
+    TraceSpan(TraceSpan const &) = delete;
+    TraceSpan &operator=(TraceSpan const &) = delete;
+
+private:
+    char const *category_;
+    char const *name_;
+    std::string detail_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Writes every span recorded so far, on every thread.
+[[nodiscard]]
+bool WriteTrace(std::filesystem::path const &path);
+
+#define NESLIDES_TRACE_CONCAT_(a, b) a##b
+#define NESLIDES_TRACE_CONCAT(a, b) NESLIDES_TRACE_CONCAT_(a, b)
+#define NESLIDES_TRACE(...) TraceSpan const NESLIDES_TRACE_CONCAT(trace_span_, __LINE__){__VA_ARGS__}
+#define NESLIDES_WRITE_TRACE(path) static_cast<void>(WriteTrace(path))
+
+#else
+
+#define NESLIDES_TRACE(...) static_cast<void>(0)
+#define NESLIDES_WRITE_TRACE(path) static_cast<void>(0)
+
+#endif
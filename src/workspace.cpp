@@ -0,0 +1,160 @@
+#include "workspace.h"
+
+#include <algorithm>
+#include <future>
+
+#include "deck_io.h"
+#include "hash.h"
+#include "thread_pool.h"
+
+namespace {
+    [[nodiscard]]
+    DeckInfo MakeDeckInfo(std::filesystem::path path, Slides const &slides) {
+        DeckInfo info{.path = std::move(path), .slide_count = slides.size(), .byte_size = 0, .hash = HashBytes({})};
+
+        for (auto const &slide : slides) {
+            info.byte_size += slide.TextSize() + 1;
+            info.hash = HashBytes(slide.Bytes(), info.hash);
+        }
+
+        return info;
+    }
+
+    struct LoadedDeck final {
+        DeckInfo info;
+        std::unique_ptr<DeckStorage> storage;
+    };
+
+    [[nodiscard]]
+    LoadedDeck LoadDeck(std::filesystem::path path) {
+        LoadedDeck deck;
+        deck.info.path = std::move(path);
+
+        std::string bytes;
+        if (!ReadFile(deck.info.path, bytes))
+            return deck;
+
+        auto storage{std::make_unique<DeckStorage>()};
+        storage->arena.Reset(storage->slides, std::max<std::size_t>(CountSlides(bytes), 1));
+        std::size_t const damaged{ParseSlides(bytes, storage->slides)};
+        if (storage->slides.empty())
+            storage->slides.emplace_back();
+
+        deck.info = MakeDeckInfo(std::move(deck.info.path), storage->slides);
+        deck.info.damaged_slides = damaged;
+        deck.storage = std::move(storage);
+
+        return deck;
+    }
+}
+
+bool Workspace::Open(std::filesystem::path const &directory, ThreadPool &pool) {
+    std::error_code error;
+    std::vector<std::filesystem::path> paths;
+    for (auto const &entry : std::filesystem::directory_iterator{directory, error}) {
+        if (entry.is_regular_file(error) && entry.path().extension() == c_DeckExtension)
+            paths.emplace_back(entry.path());
+    }
+
+    if (error || paths.empty())
+        return false;
+
+    std::ranges::sort(paths);
+
+    std::vector<std::future<LoadedDeck>> pending;
+    pending.reserve(paths.size());
+    for (auto &path : paths)
+        pending.emplace_back(pool.Submit([path = std::move(path)] { return LoadDeck(path); }));
+
+    Close();
+    for (auto &future : pending) {
+        LoadedDeck deck{future.get()};
+        if (!deck.storage)
+            continue;
+
+        file_hashes_.push_back(deck.info.hash);
+        decks_.emplace_back(std::move(deck.info));
+        // The first deck is shown right away, the others are read again when switched to.
+        storages_.emplace_back(storages_.empty() ? std::move(deck.storage) : nullptr);
+    }
+
+    return IsOpen();
+}
+
+void Workspace::Close() noexcept {
+    decks_.clear();
+    storages_.clear();
+    file_hashes_.clear();
+}
+
+void Workspace::SwitchDeck(DeckStorage &editor, std::size_t from, std::size_t to) {
+    auto const copy{[](DeckStorage const &source, DeckStorage &destination) {
+        destination.arena.Reset(destination.slides, source.slides.size());
+        destination.slides.assign(source.slides.begin(), source.slides.end());
+    }};
+
+    if (from < storages_.size()) {
+        UpdateInfo(from, editor.slides);
+        if (decks_[from].hash == file_hashes_[from]) {
+            storages_[from].reset();
+        } else {
+            if (!storages_[from])
+                storages_[from] = std::make_unique<DeckStorage>();
+            copy(editor, *storages_[from]);
+        }
+    }
+
+    if (!storages_[to]) {
+        if (auto loaded{LoadDeck(decks_[to].path)}; loaded.storage) {
+            file_hashes_[to] = loaded.info.hash;
+            decks_[to] = std::move(loaded.info);
+            storages_[to] = std::move(loaded.storage);
+        } else {
+            storages_[to] = std::make_unique<DeckStorage>();
+            storages_[to]->slides.emplace_back();
+        }
+    }
+
+    // The editor holds the deck in view, the copy here would only go stale.
+    copy(*storages_[to], editor);
+    storages_[to].reset();
+}
+
+void Workspace::Saved(std::size_t deck, std::filesystem::path path, Slides const &slides) {
+    decks_[deck] = MakeDeckInfo(std::move(path), slides);
+    file_hashes_[deck] = decks_[deck].hash;
+}
+
+std::vector<std::size_t> Workspace::EditedDecks(std::size_t shown, Slides const &editor) const {
+    std::vector<std::size_t> edited;
+    for (std::size_t deck{0}; deck < decks_.size(); ++deck) {
+        auto const hash{deck == shown ? MakeDeckInfo({}, editor).hash : decks_[deck].hash};
+        if (hash != file_hashes_[deck])
+            edited.push_back(deck);
+    }
+
+    return edited;
+}
+
+bool Workspace::SaveEdited(std::size_t shown, Slides const &editor) {
+    bool saved_all{true};
+    for (auto const deck : EditedDecks(shown, editor)) {
+        auto const &slides{deck == shown ? editor : storages_[deck]->slides};
+        if (!WriteSlidesFile(decks_[deck].path, slides)) {
+            saved_all = false;
+            continue;
+        }
+
+        Saved(deck, decks_[deck].path, slides);
+        if (deck != shown)
+            storages_[deck].reset();
+    }
+
+    return saved_all;
+}
+
+void Workspace::UpdateInfo(std::size_t deck, Slides const &slides) {
+    auto const damaged{decks_[deck].damaged_slides};
+    decks_[deck] = MakeDeckInfo(std::move(decks_[deck].path), slides);
+    decks_[deck].damaged_slides = damaged;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "deck_arena.h"
+
+class ThreadPool;
+
+struct DeckInfo final {
+    std::filesystem::path path;
+    std::size_t slide_count{};
+    std::uintmax_t byte_size{};
+    std::uint64_t hash{};
+    // Slides that lost text when the file was last read, see ParseSlides.
+    std::size_t damaged_slides{};
+};
+
+// Every .neslides deck in a directory, read in parallel for their DeckInfo. Only the deck in view is kept parsed, in
+// the editor, and a deck is read again when switched to. Decks left with edits stay parsed here, each in its own
+// arena, since the disk no longer has what they hold.
+class Workspace final {
+public:
+    [[nodiscard]]
+    bool Open(std::filesystem::path const &directory, ThreadPool &pool);
+
+    void Close() noexcept;
+
+    [[nodiscard]]
+    bool IsOpen() const noexcept {
+        return !decks_.empty();
+    }
+
+    [[nodiscard]]
+    std::vector<DeckInfo> const &Decks() const noexcept {
+        return decks_;
+    }
+
+    // Stores the editor's slides back into the deck at `from` if they differ from its file and loads the slides of the
+    // deck at `to` into the editor. Each side's arena is reset, so both end up in a single allocation. A deck whose
+    // file cannot be read any more comes up as a blank slide.
+    void SwitchDeck(DeckStorage &editor, std::size_t from, std::size_t to);
+
+    // Refreshes the metadata of a deck after its slides were edited.
+    void UpdateInfo(std::size_t deck, Slides const &slides);
+
+    // Makes the deck the file its slides were just written to, e.g. by Save As, so its title and the check for edits
+    // follow the file.
+    void Saved(std::size_t deck, std::filesystem::path path, Slides const &slides);
+
+    // The decks whose slides differ from their files. The deck at `shown` is in the editor, as `editor`.
+    [[nodiscard]]
+    std::vector<std::size_t> EditedDecks(std::size_t shown, Slides const &editor) const;
+
+    // Writes every edited deck back to its file. Returns false if any could not be written, those keep their edits.
+    [[nodiscard]]
+    bool SaveEdited(std::size_t shown, Slides const &editor);
+
+private:
+    std::vector<DeckInfo> decks_;
+    // Null unless the deck is left with edits, or about to be shown after Open.
+    std::vector<std::unique_ptr<DeckStorage>> storages_;
+    // DeckInfo::hash as last read from the file.
+    std::vector<std::uint64_t> file_hashes_;
+};